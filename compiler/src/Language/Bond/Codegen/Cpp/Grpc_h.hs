@@ -6,7 +6,6 @@
 module Language.Bond.Codegen.Cpp.Grpc_h (grpc_h) where
 
 import System.FilePath
-import Data.Maybe (isNothing)
 import Data.Monoid
 import Prelude
 import qualified Data.Text.Lazy as L
@@ -53,6 +52,10 @@ grpc_h export_attribute cpp file imports declarations = ("_grpc.h", [lt|
 
     payload = maybe "void" cppType
 
+    -- type of the message(s) of a method input or result, streamed or not
+    messagePayload (Streaming t) = cppType t
+    messagePayload mt = payload (methodTypeToMaybe mt)
+
     bonded mt = bonded' (payload mt)
       where
         bonded' params =  [lt|::bond::bonded<#{padLeft}#{params}>|]
@@ -65,7 +68,8 @@ grpc_h export_attribute cpp file imports declarations = ("_grpc.h", [lt|
       where usesBondVoid = any declUses declarations
             declUses Service {serviceMethods = methods} = any methodUses methods
             declUses _ = False
-            methodUses Function {methodInput = input} = isNothing (methodTypeToMaybe input)
+            methodUses Function {methodInput = Void} = True
+            methodUses Function {} = False
             methodUses Event {} = True
 
     grpc s@Service{..} = [lt|
@@ -104,9 +108,10 @@ grpc_h export_attribute cpp file imports declarations = ("_grpc.h", [lt|
     class #{serviceName} : public ::bond::ext::grpc::detail::service
     {
     public:
-        explicit #{serviceName}(const ::bond::ext::grpc::Scheduler& scheduler)
+        explicit #{serviceName}(const ::bond::ext::grpc::Scheduler& scheduler, unsigned int receivesPerMethod = 1)
             : ::bond::ext::grpc::detail::service(
                 scheduler,
+                receivesPerMethod,
                 {
                     #{commaLineSep 5 serviceMethodName serviceMethods}
                 })
@@ -167,7 +172,7 @@ grpc_h export_attribute cpp file imports declarations = ("_grpc.h", [lt|
           where
             static m = [lt|(void)#{methodMetadataVar m};|]
 
-        methodTemplate m = [lt|typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<#{declName}, #{payload $ methodTypeToMaybe (methodInput m)}, #{resultType m}, &#{methodMetadataVar m}> {} #{methodName m};|]
+        methodTemplate m = [lt|typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<#{declName}, #{messagePayload (methodInput m)}, #{resultType m}, &#{methodMetadataVar m}> {} #{methodName m};|]
 
         proxyName = "Client" :: String
         serviceName = "Service" :: String
@@ -175,6 +180,26 @@ grpc_h export_attribute cpp file imports declarations = ("_grpc.h", [lt|
         serviceMethodsWithIndex :: [(Integer,Method)]
         serviceMethodsWithIndex = zip [0..] serviceMethods
 
+        publicProxyMethodDecl Function{methodInput = Streaming input, methodResult = Streaming result, ..} = [lt|::bond::ext::grpc::client_stream_writer<#{cppType input}> Async#{methodName}(const ::std::function<void(#{bonded (Just result)})>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            return ::bond::ext::grpc::detail::client::dispatch_bidi_streaming<#{cppType input}>(_m#{methodName}, std::move(context), onMessage, onFinish);
+        }|]
+        publicProxyMethodDecl Function{methodInput = Streaming input, ..} = [lt|::bond::ext::grpc::client_stream_writer<#{cppType input}> Async#{methodName}(const ::std::function<void(::bond::ext::grpc::unary_call_result<#{payload (methodTypeToMaybe methodResult)}>)>& cb, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            return ::bond::ext::grpc::detail::client::dispatch_client_streaming<#{cppType input}>(_m#{methodName}, std::move(context), cb);
+        }|]
+        publicProxyMethodDecl Function{methodInput = Void, methodResult = Streaming result, ..} = [lt|void Async#{methodName}(const ::std::function<void(#{bonded (Just result)})>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            ::bond::ext::grpc::detail::client::dispatch_server_streaming(_m#{methodName}, std::move(context), onMessage, onFinish);
+        }|]
+        publicProxyMethodDecl Function{methodResult = Streaming result, ..} = [lt|void Async#{methodName}(const #{bonded (methodTypeToMaybe methodInput)}& request, const ::std::function<void(#{bonded (Just result)})>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            ::bond::ext::grpc::detail::client::dispatch_server_streaming(_m#{methodName}, std::move(context), onMessage, onFinish, request);
+        }
+        void Async#{methodName}(const #{payload (methodTypeToMaybe methodInput)}& request, const ::std::function<void(#{bonded (Just result)})>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            ::bond::ext::grpc::detail::client::dispatch_server_streaming(_m#{methodName}, std::move(context), onMessage, onFinish, request);
+        }|]
         publicProxyMethodDecl Function{methodInput = Void, ..} = [lt|void Async#{methodName}(const ::std::function<void(::bond::ext::grpc::unary_call_result<#{payload (methodTypeToMaybe methodResult)}>)>& cb, ::std::shared_ptr<::grpc::ClientContext> context = {})
         {
             ::bond::ext::grpc::detail::client::dispatch(_m#{methodName}, std::move(context), cb);
@@ -212,15 +237,32 @@ grpc_h export_attribute cpp file imports declarations = ("_grpc.h", [lt|
             ::bond::ext::grpc::detail::client::dispatch(_m#{methodName}, std::move(context), {}, request);
         }|]
 
-        privateProxyMethodDecl f = [lt|const ::bond::ext::grpc::detail::client::Method _m#{methodName f}{ ::bond::ext::grpc::detail::client::make_method("/#{getDeclTypeName idl s}/#{methodName f}") };|]
+        privateProxyMethodDecl f = [lt|const ::bond::ext::grpc::detail::client::Method _m#{methodName f}{ ::bond::ext::grpc::detail::client::make_method("/#{getDeclTypeName idl s}/#{methodName f}"#{rpcTypeArg f}) };|]
+          where
+            rpcTypeArg = maybe mempty (\t -> [lt|, ::grpc::internal::RpcMethod::#{t}|]) . rpcType
+
+        serviceMethodName f = case rpcType f of
+            Nothing -> [lt|"/#{getDeclTypeName idl s}/#{methodName f}"|]
+            Just t -> [lt|{ "/#{getDeclTypeName idl s}/#{methodName f}", ::grpc::internal::RpcMethod::#{t} }|]
 
-        serviceMethodName f = [lt|"/#{getDeclTypeName idl s}/#{methodName f}"|]
+        -- kind of gRPC method, for streaming methods only
+        rpcType :: Method -> Maybe String
+        rpcType Function{methodInput = Streaming _, methodResult = Streaming _} = Just "BIDI_STREAMING"
+        rpcType Function{methodInput = Streaming _} = Just "CLIENT_STREAMING"
+        rpcType Function{methodResult = Streaming _} = Just "SERVER_STREAMING"
+        rpcType _ = Nothing
 
         serviceDataMember (index,f) = [lt|::bond::ext::grpc::detail::service::Method _m#{index}{ _s, #{index}, ::bond::ext::grpc::detail::service::make_callback(&#{serviceName}::#{methodName f}, _s) };|]
 
-        serviceVirtualMethod f = [lt|virtual void #{methodName f}(::bond::ext::grpc::unary_call<#{payload $ methodTypeToMaybe $ methodInput f}, #{resultType f}>) = 0;|]
+        serviceVirtualMethod f = [lt|virtual void #{methodName f}(::bond::ext::grpc::#{callType f}<#{messagePayload $ methodInput f}, #{resultType f}>) = 0;|]
+          where
+            callType :: Method -> String
+            callType Function{methodInput = Streaming _, methodResult = Streaming _} = "bidi_streaming_call"
+            callType Function{methodInput = Streaming _} = "client_streaming_call"
+            callType Function{methodResult = Streaming _} = "server_streaming_call"
+            callType _ = "unary_call"
 
-        resultType Function{..} = payload (methodTypeToMaybe methodResult)
+        resultType Function{..} = messagePayload methodResult
         resultType Event{} = "::bond::reflection::nothing"
 
     grpc _ = mempty
@@ -148,6 +148,10 @@ tests = testGroup "Compiler tests"
                     [ "c++"
                     ]
                     "service_attributes"
+                , verifyCppGrpcCodegen
+                    [ "c++"
+                    ]
+                    "streaming"
                 ]
             ]
         , testGroup "C#"
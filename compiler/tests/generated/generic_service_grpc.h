@@ -153,9 +153,10 @@ template <typename Payload>
     class Service : public ::bond::ext::grpc::detail::service
     {
     public:
-        explicit Service(const ::bond::ext::grpc::Scheduler& scheduler)
+        explicit Service(const ::bond::ext::grpc::Scheduler& scheduler, unsigned int receivesPerMethod = 1)
             : ::bond::ext::grpc::detail::service(
                 scheduler,
+                receivesPerMethod,
                 {
                     "/tests.Foo/foo31",
                     "/tests.Foo/foo32",
@@ -0,0 +1,34 @@
+
+#include "streaming_reflection.h"
+#include "streaming_grpc.h"
+
+namespace tests
+{
+    
+    const ::bond::Metadata Foo::Schema::metadata
+        = ::bond::reflection::MetadataInit("Foo", "tests.Foo",
+                ::bond::reflection::Attributes());
+    
+    const ::bond::Metadata Foo::Schema::s_foo31_metadata
+        = ::bond::reflection::MetadataInit("foo31");
+    
+    const ::bond::Metadata Foo::Schema::s_foo32_metadata
+        = ::bond::reflection::MetadataInit("foo32");
+    
+    const ::bond::Metadata Foo::Schema::s_foo33_metadata
+        = ::bond::reflection::MetadataInit("foo33");
+    
+    const ::bond::Metadata Foo::Schema::s_foo34_metadata
+        = ::bond::reflection::MetadataInit("foo34");
+    
+    const ::bond::Metadata Foo::Schema::s_foo35_metadata
+        = ::bond::reflection::MetadataInit("foo35");
+    
+    const ::bond::Metadata Foo::Schema::s_shouldBeUnary_metadata
+        = ::bond::reflection::MetadataInit("shouldBeUnary");
+    
+    const ::bond::Metadata Foo::Schema::s_shouldBeStreaming_metadata
+        = ::bond::reflection::MetadataInit("shouldBeStreaming");
+
+    
+} // namespace tests
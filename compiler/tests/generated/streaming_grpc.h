@@ -0,0 +1,302 @@
+
+#pragma once
+
+#include "streaming_reflection.h"
+#include "streaming_types.h"
+#include "basic_types_grpc.h"
+#include <bond/core/bond_reflection.h>
+#include <bond/core/bonded.h>
+#include <bond/ext/grpc/reflection.h>
+#include <bond/ext/grpc/detail/client.h>
+#include <bond/ext/grpc/detail/service.h>
+
+#include <boost/optional/optional.hpp>
+#include <functional>
+#include <memory>
+
+namespace tests
+{
+
+struct Foo final
+{
+    struct Schema
+    {
+        static const ::bond::Metadata metadata;
+
+        private: static const ::bond::Metadata s_foo31_metadata;
+        private: static const ::bond::Metadata s_foo32_metadata;
+        private: static const ::bond::Metadata s_foo33_metadata;
+        private: static const ::bond::Metadata s_foo34_metadata;
+        private: static const ::bond::Metadata s_foo35_metadata;
+        private: static const ::bond::Metadata s_shouldBeUnary_metadata;
+        private: static const ::bond::Metadata s_shouldBeStreaming_metadata;
+
+        public: struct service
+        {
+            typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<Foo, void, ::tests::BasicTypes, &s_foo31_metadata> {} foo31;
+            typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<Foo, void, ::tests::BasicTypes, &s_foo32_metadata> {} foo32;
+            typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<Foo, ::tests::BasicTypes, void, &s_foo33_metadata> {} foo33;
+            typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<Foo, ::tests::BasicTypes, ::tests::BasicTypes, &s_foo34_metadata> {} foo34;
+            typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<Foo, ::tests::BasicTypes, ::tests::BasicTypes, &s_foo35_metadata> {} foo35;
+            typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<Foo, ::tests::stream, ::tests::stream, &s_shouldBeUnary_metadata> {} shouldBeUnary;
+            typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<Foo, ::tests::stream, ::tests::stream, &s_shouldBeStreaming_metadata> {} shouldBeStreaming;
+        };
+
+        private: typedef boost::mpl::list<> methods0;
+        private: typedef boost::mpl::push_front<methods0, service::shouldBeStreaming>::type methods1;
+        private: typedef boost::mpl::push_front<methods1, service::shouldBeUnary>::type methods2;
+        private: typedef boost::mpl::push_front<methods2, service::foo35>::type methods3;
+        private: typedef boost::mpl::push_front<methods3, service::foo34>::type methods4;
+        private: typedef boost::mpl::push_front<methods4, service::foo33>::type methods5;
+        private: typedef boost::mpl::push_front<methods5, service::foo32>::type methods6;
+        private: typedef boost::mpl::push_front<methods6, service::foo31>::type methods7;
+
+        public: typedef methods7::type methods;
+
+        
+    };
+
+    class Client : public ::bond::ext::grpc::detail::client
+    {
+    public:
+        using ::bond::ext::grpc::detail::client::client;
+
+        void Asyncfoo31(const ::std::function<void(::bond::bonded< ::tests::BasicTypes>)>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            ::bond::ext::grpc::detail::client::dispatch_server_streaming(_mfoo31, std::move(context), onMessage, onFinish);
+        }
+
+        void Asyncfoo32(const ::std::function<void(::bond::bonded< ::tests::BasicTypes>)>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            ::bond::ext::grpc::detail::client::dispatch_server_streaming(_mfoo32, std::move(context), onMessage, onFinish);
+        }
+
+        ::bond::ext::grpc::client_stream_writer<::tests::BasicTypes> Asyncfoo33(const ::std::function<void(::bond::ext::grpc::unary_call_result<void>)>& cb, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            return ::bond::ext::grpc::detail::client::dispatch_client_streaming<::tests::BasicTypes>(_mfoo33, std::move(context), cb);
+        }
+
+        ::bond::ext::grpc::client_stream_writer<::tests::BasicTypes> Asyncfoo34(const ::std::function<void(::bond::ext::grpc::unary_call_result<::tests::BasicTypes>)>& cb, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            return ::bond::ext::grpc::detail::client::dispatch_client_streaming<::tests::BasicTypes>(_mfoo34, std::move(context), cb);
+        }
+
+        ::bond::ext::grpc::client_stream_writer<::tests::BasicTypes> Asyncfoo35(const ::std::function<void(::bond::bonded< ::tests::BasicTypes>)>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            return ::bond::ext::grpc::detail::client::dispatch_bidi_streaming<::tests::BasicTypes>(_mfoo35, std::move(context), onMessage, onFinish);
+        }
+
+        void AsyncshouldBeUnary(const ::bond::bonded< ::tests::stream>& request, const ::std::function<void(::bond::ext::grpc::unary_call_result<::tests::stream>)>& cb, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            ::bond::ext::grpc::detail::client::dispatch(_mshouldBeUnary, std::move(context), cb, request);
+        }
+        std::future<::bond::ext::grpc::unary_call_result<::tests::stream>> AsyncshouldBeUnary(const ::bond::bonded< ::tests::stream>& request, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            return ::bond::ext::grpc::detail::client::dispatch<::tests::stream>(_mshouldBeUnary, std::move(context), request);
+        }
+        void AsyncshouldBeUnary(const ::tests::stream& request, const ::std::function<void(::bond::ext::grpc::unary_call_result<::tests::stream>)>& cb, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            ::bond::ext::grpc::detail::client::dispatch(_mshouldBeUnary, std::move(context), cb, request);
+        }
+        ::std::future<::bond::ext::grpc::unary_call_result<::tests::stream>> AsyncshouldBeUnary(const ::tests::stream& request, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            return ::bond::ext::grpc::detail::client::dispatch<::tests::stream>(_mshouldBeUnary, std::move(context), request);
+        }
+
+        ::bond::ext::grpc::client_stream_writer<::tests::stream> AsyncshouldBeStreaming(const ::std::function<void(::bond::bonded< ::tests::stream>)>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            return ::bond::ext::grpc::detail::client::dispatch_bidi_streaming<::tests::stream>(_mshouldBeStreaming, std::move(context), onMessage, onFinish);
+        }
+
+    private:
+        const ::bond::ext::grpc::detail::client::Method _mfoo31{ ::bond::ext::grpc::detail::client::make_method("/tests.Foo/foo31", ::grpc::internal::RpcMethod::SERVER_STREAMING) };
+        const ::bond::ext::grpc::detail::client::Method _mfoo32{ ::bond::ext::grpc::detail::client::make_method("/tests.Foo/foo32", ::grpc::internal::RpcMethod::SERVER_STREAMING) };
+        const ::bond::ext::grpc::detail::client::Method _mfoo33{ ::bond::ext::grpc::detail::client::make_method("/tests.Foo/foo33", ::grpc::internal::RpcMethod::CLIENT_STREAMING) };
+        const ::bond::ext::grpc::detail::client::Method _mfoo34{ ::bond::ext::grpc::detail::client::make_method("/tests.Foo/foo34", ::grpc::internal::RpcMethod::CLIENT_STREAMING) };
+        const ::bond::ext::grpc::detail::client::Method _mfoo35{ ::bond::ext::grpc::detail::client::make_method("/tests.Foo/foo35", ::grpc::internal::RpcMethod::BIDI_STREAMING) };
+        const ::bond::ext::grpc::detail::client::Method _mshouldBeUnary{ ::bond::ext::grpc::detail::client::make_method("/tests.Foo/shouldBeUnary") };
+        const ::bond::ext::grpc::detail::client::Method _mshouldBeStreaming{ ::bond::ext::grpc::detail::client::make_method("/tests.Foo/shouldBeStreaming", ::grpc::internal::RpcMethod::BIDI_STREAMING) };
+    };
+
+    class Service : public ::bond::ext::grpc::detail::service
+    {
+    public:
+        explicit Service(const ::bond::ext::grpc::Scheduler& scheduler, unsigned int receivesPerMethod = 1)
+            : ::bond::ext::grpc::detail::service(
+                scheduler,
+                receivesPerMethod,
+                {
+                    { "/tests.Foo/foo31", ::grpc::internal::RpcMethod::SERVER_STREAMING },
+                    { "/tests.Foo/foo32", ::grpc::internal::RpcMethod::SERVER_STREAMING },
+                    { "/tests.Foo/foo33", ::grpc::internal::RpcMethod::CLIENT_STREAMING },
+                    { "/tests.Foo/foo34", ::grpc::internal::RpcMethod::CLIENT_STREAMING },
+                    { "/tests.Foo/foo35", ::grpc::internal::RpcMethod::BIDI_STREAMING },
+                    "/tests.Foo/shouldBeUnary",
+                    { "/tests.Foo/shouldBeStreaming", ::grpc::internal::RpcMethod::BIDI_STREAMING }
+                })
+        {}
+
+        virtual void foo31(::bond::ext::grpc::server_streaming_call<void, ::tests::BasicTypes>) = 0;
+        virtual void foo32(::bond::ext::grpc::server_streaming_call<void, ::tests::BasicTypes>) = 0;
+        virtual void foo33(::bond::ext::grpc::client_streaming_call<::tests::BasicTypes, void>) = 0;
+        virtual void foo34(::bond::ext::grpc::client_streaming_call<::tests::BasicTypes, ::tests::BasicTypes>) = 0;
+        virtual void foo35(::bond::ext::grpc::bidi_streaming_call<::tests::BasicTypes, ::tests::BasicTypes>) = 0;
+        virtual void shouldBeUnary(::bond::ext::grpc::unary_call<::tests::stream, ::tests::stream>) = 0;
+        virtual void shouldBeStreaming(::bond::ext::grpc::bidi_streaming_call<::tests::stream, ::tests::stream>) = 0;
+
+    private:
+        void start() override
+        {
+            _data.emplace(*this);
+        }
+
+        struct data
+        {
+            explicit data(Service& s)
+                : _s(s)
+            {}
+
+            Service& _s;
+            ::bond::ext::grpc::detail::service::Method _m0{ _s, 0, ::bond::ext::grpc::detail::service::make_callback(&Service::foo31, _s) };
+            ::bond::ext::grpc::detail::service::Method _m1{ _s, 1, ::bond::ext::grpc::detail::service::make_callback(&Service::foo32, _s) };
+            ::bond::ext::grpc::detail::service::Method _m2{ _s, 2, ::bond::ext::grpc::detail::service::make_callback(&Service::foo33, _s) };
+            ::bond::ext::grpc::detail::service::Method _m3{ _s, 3, ::bond::ext::grpc::detail::service::make_callback(&Service::foo34, _s) };
+            ::bond::ext::grpc::detail::service::Method _m4{ _s, 4, ::bond::ext::grpc::detail::service::make_callback(&Service::foo35, _s) };
+            ::bond::ext::grpc::detail::service::Method _m5{ _s, 5, ::bond::ext::grpc::detail::service::make_callback(&Service::shouldBeUnary, _s) };
+            ::bond::ext::grpc::detail::service::Method _m6{ _s, 6, ::bond::ext::grpc::detail::service::make_callback(&Service::shouldBeStreaming, _s) };
+        };
+
+        ::boost::optional<data> _data;
+    };
+};
+
+
+
+
+    
+template <typename T>
+    struct Bar final
+{
+    struct Schema
+    {
+        static const ::bond::Metadata metadata;
+
+        private: static const ::bond::Metadata s_ClientStreaming_metadata;
+        private: static const ::bond::Metadata s_ServerStreaming_metadata;
+        private: static const ::bond::Metadata s_DuplexStreaming_metadata;
+
+        public: struct service
+        {
+            typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<Bar, T, ::tests::BasicTypes, &s_ClientStreaming_metadata> {} ClientStreaming;
+            typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<Bar, ::tests::BasicTypes, T, &s_ServerStreaming_metadata> {} ServerStreaming;
+            typedef struct : ::bond::ext::grpc::reflection::MethodTemplate<Bar, T, T, &s_DuplexStreaming_metadata> {} DuplexStreaming;
+        };
+
+        private: typedef boost::mpl::list<> methods0;
+        private: typedef typename boost::mpl::push_front<methods0, typename service::DuplexStreaming>::type methods1;
+        private: typedef typename boost::mpl::push_front<methods1, typename service::ServerStreaming>::type methods2;
+        private: typedef typename boost::mpl::push_front<methods2, typename service::ClientStreaming>::type methods3;
+
+        public: typedef typename methods3::type methods;
+
+        Schema()
+        {
+            // Force instantiation of template statics
+            (void)metadata;
+            (void)s_ClientStreaming_metadata;
+            (void)s_ServerStreaming_metadata;
+            (void)s_DuplexStreaming_metadata;
+        }
+    };
+
+    class Client : public ::bond::ext::grpc::detail::client
+    {
+    public:
+        using ::bond::ext::grpc::detail::client::client;
+
+        ::bond::ext::grpc::client_stream_writer<T> AsyncClientStreaming(const ::std::function<void(::bond::ext::grpc::unary_call_result<::tests::BasicTypes>)>& cb, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            return ::bond::ext::grpc::detail::client::dispatch_client_streaming<T>(_mClientStreaming, std::move(context), cb);
+        }
+
+        void AsyncServerStreaming(const ::bond::bonded< ::tests::BasicTypes>& request, const ::std::function<void(::bond::bonded<T>)>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            ::bond::ext::grpc::detail::client::dispatch_server_streaming(_mServerStreaming, std::move(context), onMessage, onFinish, request);
+        }
+        void AsyncServerStreaming(const ::tests::BasicTypes& request, const ::std::function<void(::bond::bonded<T>)>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            ::bond::ext::grpc::detail::client::dispatch_server_streaming(_mServerStreaming, std::move(context), onMessage, onFinish, request);
+        }
+
+        ::bond::ext::grpc::client_stream_writer<T> AsyncDuplexStreaming(const ::std::function<void(::bond::bonded<T>)>& onMessage, const ::std::function<void(const ::grpc::Status&)>& onFinish, ::std::shared_ptr<::grpc::ClientContext> context = {})
+        {
+            return ::bond::ext::grpc::detail::client::dispatch_bidi_streaming<T>(_mDuplexStreaming, std::move(context), onMessage, onFinish);
+        }
+
+    private:
+        const ::bond::ext::grpc::detail::client::Method _mClientStreaming{ ::bond::ext::grpc::detail::client::make_method("/tests.Bar/ClientStreaming", ::grpc::internal::RpcMethod::CLIENT_STREAMING) };
+        const ::bond::ext::grpc::detail::client::Method _mServerStreaming{ ::bond::ext::grpc::detail::client::make_method("/tests.Bar/ServerStreaming", ::grpc::internal::RpcMethod::SERVER_STREAMING) };
+        const ::bond::ext::grpc::detail::client::Method _mDuplexStreaming{ ::bond::ext::grpc::detail::client::make_method("/tests.Bar/DuplexStreaming", ::grpc::internal::RpcMethod::BIDI_STREAMING) };
+    };
+
+    class Service : public ::bond::ext::grpc::detail::service
+    {
+    public:
+        explicit Service(const ::bond::ext::grpc::Scheduler& scheduler, unsigned int receivesPerMethod = 1)
+            : ::bond::ext::grpc::detail::service(
+                scheduler,
+                receivesPerMethod,
+                {
+                    { "/tests.Bar/ClientStreaming", ::grpc::internal::RpcMethod::CLIENT_STREAMING },
+                    { "/tests.Bar/ServerStreaming", ::grpc::internal::RpcMethod::SERVER_STREAMING },
+                    { "/tests.Bar/DuplexStreaming", ::grpc::internal::RpcMethod::BIDI_STREAMING }
+                })
+        {}
+
+        virtual void ClientStreaming(::bond::ext::grpc::client_streaming_call<T, ::tests::BasicTypes>) = 0;
+        virtual void ServerStreaming(::bond::ext::grpc::server_streaming_call<::tests::BasicTypes, T>) = 0;
+        virtual void DuplexStreaming(::bond::ext::grpc::bidi_streaming_call<T, T>) = 0;
+
+    private:
+        void start() override
+        {
+            _data.emplace(*this);
+        }
+
+        struct data
+        {
+            explicit data(Service& s)
+                : _s(s)
+            {}
+
+            Service& _s;
+            ::bond::ext::grpc::detail::service::Method _m0{ _s, 0, ::bond::ext::grpc::detail::service::make_callback(&Service::ClientStreaming, _s) };
+            ::bond::ext::grpc::detail::service::Method _m1{ _s, 1, ::bond::ext::grpc::detail::service::make_callback(&Service::ServerStreaming, _s) };
+            ::bond::ext::grpc::detail::service::Method _m2{ _s, 2, ::bond::ext::grpc::detail::service::make_callback(&Service::DuplexStreaming, _s) };
+        };
+
+        ::boost::optional<data> _data;
+    };
+};
+
+
+    template <typename T>
+    const ::bond::Metadata Bar<T>::Schema::metadata
+        = ::bond::reflection::MetadataInit<boost::mpl::list<T> >("Bar", "tests.Bar",
+                ::bond::reflection::Attributes());
+    
+    template <typename T>
+    const ::bond::Metadata Bar<T>::Schema::s_ClientStreaming_metadata
+        = ::bond::reflection::MetadataInit("ClientStreaming");
+    
+    template <typename T>
+    const ::bond::Metadata Bar<T>::Schema::s_ServerStreaming_metadata
+        = ::bond::reflection::MetadataInit("ServerStreaming");
+    
+    template <typename T>
+    const ::bond::Metadata Bar<T>::Schema::s_DuplexStreaming_metadata
+        = ::bond::reflection::MetadataInit("DuplexStreaming");
+
+
+} // namespace tests
+
@@ -0,0 +1,12 @@
+
+#include "streaming_reflection.h"
+#include <bond/core/exception.h>
+
+namespace tests
+{
+    
+    const ::bond::Metadata stream::Schema::metadata
+        = stream::Schema::GetMetadata();
+
+    
+} // namespace tests
@@ -8,6 +8,7 @@
 
 #include "apply.h"
 #include "select_protocol.h"
+#include "detail/serialized_size.h"
 
 /// namespace bond
 namespace bond
@@ -22,6 +23,38 @@ inline void Serialize(const T& obj, Writer& output)
 }
 
 
+/// @brief Get the number of bytes produced by serializing an object using
+/// the protocol of the specified writer
+///
+/// The size is computed by serializing the object to a counter, without
+/// writing the payload. For protocols serializing in two passes, such as
+/// Compact Binary v2, only the counting pass is performed.
+template <typename Writer, typename Protocols = BuiltInProtocols, typename T>
+inline uint32_t GetSerializedSize(const T& obj,
+    uint16_t version = default_version<typename Writer::Reader>::value)
+{
+    typedef typename get_protocol_writer<typename Writer::Reader, OutputBuffer>::type BufferWriter;
+
+    return detail::GetSerializedSize<Protocols, BufferWriter>(obj, version);
+}
+
+
+/// @brief Serialize an object using the protocol of the specified writer
+/// into a single buffer of the exact size of the payload
+///
+/// The size of the payload is computed first (see GetSerializedSize) so that
+/// only one buffer is allocated and returned as is, without the chain of
+/// buffers and the final concatenation of OutputBuffer::GetBuffer.
+template <typename Writer, typename Protocols = BuiltInProtocols, typename T>
+inline blob Serialize(const T& obj,
+    uint16_t version = default_version<typename Writer::Reader>::value)
+{
+    typedef typename get_protocol_writer<typename Writer::Reader, OutputBuffer>::type BufferWriter;
+
+    return detail::SerializeExact<Protocols, BufferWriter>(obj, version);
+}
+
+
 /// @brief Deserialize an object from a protocol reader
 template <typename Protocols = BuiltInProtocols, typename Reader, typename T>
 inline void Deserialize(Reader input, T& obj)
@@ -58,6 +91,22 @@ inline T Deserialize(Reader input, const RuntimeSchema& schema)
 }
 
 
+/// @brief Transcode a payload of type T from a protocol reader to a protocol writer
+///
+/// The payload is parsed by the reader type itself, using the compile-time
+/// schema of T, and written without creating an intermediate object. Unlike
+/// serializing a bonded<T>, which type-erases the reader as ProtocolReader,
+/// there is no dispatch on the protocol and the parser is instantiated only
+/// for the specified reader and writer. Compact Binary v2 writers serialize
+/// in two passes, reading the input twice, unless they are constructed to
+/// write struct lengths in a single pass.
+template <typename T, typename Protocols = BuiltInProtocols, typename Reader, typename Writer>
+inline void Transcode(Reader input, Writer& output)
+{
+    Apply<Protocols>(Serializer<Writer, Protocols>(output), bonded<T, Reader&>(input));
+}
+
+
 /// @brief Marshal an object using a protocol writer
 template <typename Protocols, typename T, typename Writer>
 inline void Marshal(const T& obj, Writer& output)
@@ -52,6 +52,11 @@ struct BuiltInProtocols;
 template <typename T, typename Protocols = BuiltInProtocols, typename Validator = RequiredFieldValiadator<T> >
 class To;
 
+class FieldSet;
+
+template <typename T, typename Protocols = BuiltInProtocols>
+class ProjectTo;
+
 template <typename T, typename Enable = void> struct
 schema_for_passthrough;
 
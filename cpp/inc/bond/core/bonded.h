@@ -187,6 +187,15 @@ public:
         Apply<Protocols>(To<X, Protocols>(var), *this);
     }
 
+    /// @brief Deserialize the specified fields to an object of type X
+    ///
+    /// Fields with ids not in the set are skipped and left default-initialized.
+    template <typename Protocols = BuiltInProtocols, typename X>
+    void Deserialize(X& var, const FieldSet& fields) const
+    {
+        Apply<Protocols>(ProjectTo<X, Protocols>(var, fields), *this);
+    }
+
     /// @brief Deserialize to a bonded<U>
     template <typename Protocols = BuiltInProtocols, typename U>
     typename boost::enable_if<is_marshaled_bonded<T, Reader, U> >::type
@@ -107,6 +107,15 @@ public:
     }
 
 
+    /// @brief Deserialize the specified fields to an object of type T
+    ///
+    /// Fields with ids not in the set are skipped and left default-initialized.
+    template <typename Protocols = BuiltInProtocols, typename T>
+    void Deserialize(T& var, const FieldSet& fields) const
+    {
+        Apply<Protocols>(ProjectTo<T, Protocols>(var, fields), *this);
+    }
+
     /// @brief Deserialize to a bonded<T>
     template <typename Protocols = BuiltInProtocols, typename T>
     typename boost::enable_if<uses_marshaled_bonded<Reader, T> >::type
@@ -0,0 +1,628 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "detail/double_pass.h"
+#include "detail/omit_default.h"
+#include "exception.h"
+#include "protocol.h"
+#include "reflection.h"
+#include "runtime_schema.h"
+#include "schema.h"
+#include "traits.h"
+#include "transforms.h"
+
+#include <boost/static_assert.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bond
+{
+
+/// @brief Runtime schema compiled to flat tables for repeated use
+///
+/// Walking a RuntimeSchema creates a RuntimeSchema, and often a SchemaDef,
+/// for every nested struct and container, which dominates the cost of
+/// transcoding or skipping payloads with a schema known only at runtime.
+/// CompiledSchema resolves the schema once into contiguous tables of
+/// structs, fields and types that refer to each other by index, so that
+/// payloads can be processed without any allocation for the schema.
+/// The object keeps a reference to the SchemaDef and can be shared between
+/// threads.
+class CompiledSchema
+{
+public:
+    /// @brief Type of a field, list/set element or map key/value
+    struct Type
+    {
+        BondDataType id;
+        bool bonded;
+        uint32_t structIndex;   // index in structs() of a BT_STRUCT type
+        uint32_t element;       // index in types() of the element of a container
+        uint32_t key;           // index in types() of the key of a map
+    };
+
+    /// @brief Field of a struct
+    struct Field
+    {
+        uint16_t id;
+        BondDataType type;
+        uint32_t typeIndex;     // index in types()
+        const Metadata* metadata;
+    };
+
+    /// @brief Struct, with fields in the order of the schema
+    struct Struct
+    {
+        const Metadata* metadata;
+        uint32_t base;          // index in structs() of the base, or npos
+        uint32_t fields;        // index in fields() of the first field
+        uint32_t fieldCount;
+    };
+
+    /// @brief Index used for absent references, e.g. a struct without base
+    static uint32_t npos()
+    {
+        return 0xffffffff;
+    }
+
+    /// @brief Compile the struct type of the specified runtime schema
+    explicit CompiledSchema(const RuntimeSchema& schema)
+        : _schema(schema)
+    {
+        if (schema.GetTypeId() != BT_STRUCT)
+        {
+            BOND_THROW(CoreException, "Only struct schemas can be compiled");
+        }
+
+        const SchemaDef& def = schema.GetSchema();
+
+        // Structs are indexed like SchemaDef::structs so that the struct_def
+        // of types can be used directly.
+        _structs.reserve(def.structs.size());
+
+        for (const StructDef& s : def.structs)
+        {
+            Struct compiled;
+
+            compiled.metadata = &s.metadata;
+            compiled.base = s.base_def.empty() ? npos() : s.base_def.value().struct_def;
+            compiled.fields = static_cast<uint32_t>(_fields.size());
+            compiled.fieldCount = static_cast<uint32_t>(s.fields.size());
+
+            for (const FieldDef& f : s.fields)
+            {
+                Field field;
+
+                field.id = f.id;
+                field.type = f.type.id;
+                field.typeIndex = AddType(f.type);
+                field.metadata = &f.metadata;
+
+                _fields.push_back(field);
+            }
+
+            _structs.push_back(compiled);
+        }
+
+        _root = schema.GetType().struct_def;
+    }
+
+    /// @brief Index in structs() of the compiled struct
+    uint32_t root() const
+    {
+        return _root;
+    }
+
+    const std::vector<Struct>& structs() const
+    {
+        return _structs;
+    }
+
+    const std::vector<Field>& fields() const
+    {
+        return _fields;
+    }
+
+    const std::vector<Type>& types() const
+    {
+        return _types;
+    }
+
+    /// @brief Runtime schema the object was compiled from
+    const RuntimeSchema& GetRuntimeSchema() const
+    {
+        return _schema;
+    }
+
+private:
+    uint32_t AddType(const TypeDef& def)
+    {
+        const uint32_t index = static_cast<uint32_t>(_types.size());
+
+        Type type;
+
+        type.id = def.id;
+        type.bonded = def.bonded_type;
+        type.structIndex = def.id == BT_STRUCT ? def.struct_def : npos();
+        type.element = npos();
+        type.key = npos();
+
+        _types.push_back(type);
+
+        // Nested types are appended after the container type so the
+        // references must be set by index.
+        if (!def.element.empty())
+        {
+            const uint32_t element = AddType(def.element.value());
+            _types[index].element = element;
+        }
+
+        if (!def.key.empty())
+        {
+            const uint32_t key = AddType(def.key.value());
+            _types[index].key = key;
+        }
+
+        return index;
+    }
+
+    RuntimeSchema _schema;
+    std::vector<Struct> _structs;
+    std::vector<Field> _fields;
+    std::vector<Type> _types;
+    uint32_t _root;
+};
+
+
+namespace detail
+{
+
+// Interpreter transcoding tagged payload using a compiled schema. The output
+// is the same as the output of Serializer applied to bonded<void> with the
+// runtime schema the plan was compiled from.
+template <typename Reader, typename Writer>
+class CompiledTranscoder
+{
+public:
+    CompiledTranscoder(const CompiledSchema& schema, Reader& input, Writer& output)
+        : _schema(schema),
+          _input(input),
+          _output(output)
+    {}
+
+    void Struct(uint32_t index, bool base)
+    {
+        // Structs that don't match the schema are transcoded as Unknown
+        const CompiledSchema::Struct* def =
+            index != CompiledSchema::npos() ? &_schema.structs()[index] : nullptr;
+
+        detail::StructBegin(_input, base);
+
+        _output.WriteStructBegin(def ? *def->metadata : schema<Unknown>::type::metadata, base);
+
+        if (def && def->base != CompiledSchema::npos())
+        {
+            Struct(def->base, true);
+        }
+
+        uint16_t     id;
+        BondDataType type;
+
+        _input.ReadFieldBegin(type, id);
+
+        if (def)
+        {
+            Fields(*def, id, type);
+        }
+
+        // Remaining fields, including the fields of a deeper hierarchy than
+        // the schema, are written as unknown.
+        if (!base)
+        {
+            for (; type != BT_STOP; NextField(type, id))
+            {
+                if (type == BT_STOP_BASE)
+                    _output.WriteStructEnd(true);
+                else
+                    UnknownField(id, type);
+            }
+        }
+        else
+        {
+            for (; type != BT_STOP && type != BT_STOP_BASE; NextField(type, id))
+            {
+                UnknownField(id, type);
+            }
+        }
+
+        _input.ReadFieldEnd();
+
+        _output.WriteStructEnd(base);
+
+        detail::StructEnd(_input, base);
+    }
+
+private:
+    void Fields(const CompiledSchema::Struct& def, uint16_t& id, BondDataType& type)
+    {
+        const CompiledSchema::Field* it = _schema.fields().data() + def.fields;
+        const CompiledSchema::Field* const end = it + def.fieldCount;
+
+        for (;; NextField(type, id))
+        {
+            while (it != end && (it->id < id || type == BT_STOP || type == BT_STOP_BASE))
+            {
+                detail::WriteFieldOmitted(_output, it->type, it->id, *it->metadata);
+                ++it;
+            }
+
+            if (type == BT_STOP || type == BT_STOP_BASE)
+            {
+                break;
+            }
+
+            if (it != end && it->id == id)
+            {
+                const CompiledSchema::Field& field = *it++;
+
+                if (type != BT_STRUCT && type != BT_LIST && type != BT_SET && type != BT_MAP)
+                {
+                    _output.WriteFieldBegin(type, id, *field.metadata);
+                    Basic(type);
+                    _output.WriteFieldEnd();
+                    continue;
+                }
+
+                if (field.type == type)
+                {
+                    _output.WriteFieldBegin(type, id, *field.metadata);
+                    Value(type, field.typeIndex);
+                    _output.WriteFieldEnd();
+                    continue;
+                }
+            }
+
+            UnknownField(id, type);
+        }
+    }
+
+    void UnknownField(uint16_t id, BondDataType type)
+    {
+        _output.WriteFieldBegin(type, id);
+        Value(type, CompiledSchema::npos());
+        _output.WriteFieldEnd();
+    }
+
+    void NextField(BondDataType& type, uint16_t& id)
+    {
+        _input.ReadFieldEnd();
+        _input.ReadFieldBegin(type, id);
+    }
+
+    // Type index is npos when the value doesn't match the schema
+    void Value(BondDataType type, uint32_t index)
+    {
+        switch (type)
+        {
+            case BT_STRUCT:
+                Struct(index != CompiledSchema::npos()
+                    ? _schema.types()[index].structIndex : CompiledSchema::npos(), false);
+                break;
+
+            case BT_LIST:
+            case BT_SET:
+                Container(index);
+                break;
+
+            case BT_MAP:
+                Map(index);
+                break;
+
+            default:
+                Basic(type);
+                break;
+        }
+    }
+
+    void Container(uint32_t index)
+    {
+        const uint32_t element = index != CompiledSchema::npos()
+            ? _schema.types()[index].element : CompiledSchema::npos();
+
+        BondDataType type = element != CompiledSchema::npos()
+            ? _schema.types()[element].id : BT_UNAVAILABLE;
+        uint32_t     size = 0;
+
+        _input.ReadContainerBegin(size, type);
+        _output.WriteContainerBegin(size, type);
+
+        const uint32_t match = Match(element, type);
+
+        while (size--)
+        {
+            Value(type, match);
+        }
+
+        _output.WriteContainerEnd();
+        _input.ReadContainerEnd();
+    }
+
+    void Map(uint32_t index)
+    {
+        const uint32_t key = index != CompiledSchema::npos()
+            ? _schema.types()[index].key : CompiledSchema::npos();
+        const uint32_t element = index != CompiledSchema::npos()
+            ? _schema.types()[index].element : CompiledSchema::npos();
+
+        std::pair<BondDataType, BondDataType> type(
+            key != CompiledSchema::npos() ? _schema.types()[key].id : BT_UNAVAILABLE,
+            element != CompiledSchema::npos() ? _schema.types()[element].id : BT_UNAVAILABLE);
+        uint32_t size = 0;
+
+        _input.ReadContainerBegin(size, type);
+        _output.WriteContainerBegin(size, type);
+
+        const uint32_t match = Match(element, type.second);
+
+        while (size--)
+        {
+            Value(type.first, CompiledSchema::npos());
+            Value(type.second, match);
+        }
+
+        _output.WriteContainerEnd();
+        _input.ReadContainerEnd();
+    }
+
+    uint32_t Match(uint32_t index, BondDataType type) const
+    {
+        return index != CompiledSchema::npos() && _schema.types()[index].id == type
+            ? index : CompiledSchema::npos();
+    }
+
+    void Basic(BondDataType type)
+    {
+        switch (type)
+        {
+            case BT_BOOL:
+                return Basic<bool>();
+
+            case BT_UINT8:
+                return Basic<uint8_t>();
+
+            case BT_UINT16:
+                return Basic<uint16_t>();
+
+            case BT_UINT32:
+                return Basic<uint32_t>();
+
+            case BT_UINT64:
+                return Basic<uint64_t>();
+
+            case BT_FLOAT:
+                return Basic<float>();
+
+            case BT_DOUBLE:
+                return Basic<double>();
+
+            case BT_STRING:
+                _input.Read(_string);
+                return _output.Write(_string);
+
+            case BT_WSTRING:
+                _input.Read(_wstring);
+                return _output.Write(_wstring);
+
+            case BT_INT8:
+                return Basic<int8_t>();
+
+            case BT_INT16:
+                return Basic<int16_t>();
+
+            case BT_INT32:
+                return Basic<int32_t>();
+
+            case BT_INT64:
+                return Basic<int64_t>();
+
+            default:
+                BOOST_ASSERT(false);
+                return;
+        }
+    }
+
+    template <typename T>
+    void Basic()
+    {
+        T value = T();
+
+        _input.Read(value);
+        _output.Write(value);
+    }
+
+    const CompiledSchema& _schema;
+    Reader& _input;
+    Writer& _output;
+
+    // Reused to avoid allocating for every string value
+    std::string _string;
+    std::wstring _wstring;
+};
+
+
+template <typename Reader, typename Writer>
+inline void Transcode(const CompiledSchema& schema, Reader& input, Writer& output, std::false_type)
+{
+    CompiledTranscoder<Reader, Writer>(schema, input, output).Struct(schema.root(), false);
+}
+
+
+template <typename Reader, typename Writer>
+inline void Transcode(const CompiledSchema& schema, Reader& input, Writer& output, std::true_type)
+{
+    if (output.NeedPass0())
+    {
+        typename Writer::Pass0::Buffer buffer;
+        typename Writer::Pass0 pass0(buffer, output);
+
+        // The first pass reads a copy of the input
+        Reader copy(input);
+
+        CompiledTranscoder<Reader, typename Writer::Pass0>(schema, copy, pass0).Struct(schema.root(), false);
+
+        output.WithPass0(pass0), Transcode(schema, input, output, std::false_type());
+    }
+    else
+    {
+        Transcode(schema, input, output, std::false_type());
+    }
+}
+
+
+// Skips untagged payload by walking the compiled schema
+template <typename Reader>
+class CompiledSkipper
+{
+public:
+    CompiledSkipper(const CompiledSchema& schema, Reader& input)
+        : _schema(schema),
+          _input(input)
+    {}
+
+    void Struct(uint32_t index, bool base)
+    {
+        const CompiledSchema::Struct& def = _schema.structs()[index];
+
+        detail::StructBegin(_input, base);
+
+        if (def.base != CompiledSchema::npos())
+        {
+            Struct(def.base, true);
+        }
+
+        const CompiledSchema::Field* it = _schema.fields().data() + def.fields;
+
+        for (const CompiledSchema::Field* const end = it + def.fieldCount; it != end; ++it)
+        {
+            if (!detail::ReadFieldOmitted(_input))
+            {
+                Value(it->typeIndex);
+            }
+        }
+
+        detail::StructEnd(_input, base);
+    }
+
+private:
+    void Value(uint32_t index)
+    {
+        const CompiledSchema::Type& type = _schema.types()[index];
+
+        switch (type.id)
+        {
+            case BT_STRUCT:
+                if (type.bonded)
+                {
+                    // Marshaled bonded<T> is prefixed with its size
+                    uint32_t size;
+                    _input.Read(size);
+                    _input.GetBuffer().Skip(size);
+                }
+                else
+                {
+                    Struct(type.structIndex, false);
+                }
+                break;
+
+            case BT_LIST:
+            case BT_SET:
+            {
+                uint32_t     size;
+                BondDataType element = _schema.types()[type.element].id;
+
+                _input.ReadContainerBegin(size, element);
+
+                while (size--)
+                {
+                    Value(type.element);
+                }
+
+                _input.ReadContainerEnd();
+                break;
+            }
+
+            case BT_MAP:
+            {
+                uint32_t size;
+                std::pair<BondDataType, BondDataType> element(
+                    _schema.types()[type.key].id, _schema.types()[type.element].id);
+
+                _input.ReadContainerBegin(size, element);
+
+                while (size--)
+                {
+                    Value(type.key);
+                    Value(type.element);
+                }
+
+                _input.ReadContainerEnd();
+                break;
+            }
+
+            default:
+                _input.Skip(type.id);
+                break;
+        }
+    }
+
+    const CompiledSchema& _schema;
+    Reader& _input;
+};
+
+} // namespace detail
+
+
+/// @brief Transcode a struct from tagged protocol reader to protocol writer
+///
+/// The output is the same as the output of
+/// bonded<void>(input, schema.GetRuntimeSchema()).Serialize(output), without
+/// the overhead of walking the runtime schema.
+template <typename Reader, typename Writer>
+inline void Transcode(const CompiledSchema& schema, Reader& input, Writer& output)
+{
+    BOOST_STATIC_ASSERT_MSG(uses_dynamic_parser<Reader>::value,
+        "Compiled schema transcoding requires a tagged protocol reader");
+
+    BOOST_STATIC_ASSERT_MSG(!uses_marshaled_bonded<typename Writer::Reader>::value,
+        "Compiled schema transcoding doesn't support protocols with marshaled bonded<T>");
+
+    detail::Transcode(schema, input, output,
+        detail::need_double_pass<Serializer<Writer, BuiltInProtocols> >());
+}
+
+
+/// @brief Skip a struct in the payload using compiled schema
+template <typename Reader>
+typename boost::enable_if<uses_static_parser<Reader> >::type
+inline Skip(Reader& input, const CompiledSchema& schema)
+{
+    detail::CompiledSkipper<Reader>(schema, input).Struct(schema.root(), false);
+}
+
+
+/// @brief Skip a struct in the payload using compiled schema
+template <typename Reader>
+typename boost::disable_if<uses_static_parser<Reader> >::type
+inline Skip(Reader& input, const CompiledSchema& /*schema*/)
+{
+    // Tagged protocols can skip without the schema
+    input.Skip(BT_STRUCT);
+}
+
+} // namespace bond
@@ -36,6 +36,14 @@ require_modify_element
     : std::false_type {};
 
 
+// Specialize for list containers which store their elements in a contiguous
+// array and implement container_data. Lists of basic types are then read and
+// written in bulk by protocols which support it.
+template <typename T> struct
+is_contiguous_list_container
+    : std::false_type {};
+
+
 template <typename T> struct
 is_string
     : std::false_type {};
@@ -90,6 +98,12 @@ uint32_t container_size(const T& container);
 template <typename T>
 void resize_list(T& list, uint32_t size);
 
+template <typename T>
+typename element_type<T>::type* container_data(T& list);
+
+template <typename T>
+const typename element_type<T>::type* container_data(const T& list);
+
 template <typename T, typename E, typename F>
 void modify_element(T& list, E& element, F deserialize);
 
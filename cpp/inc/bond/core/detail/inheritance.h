@@ -46,6 +46,11 @@ expected_depth<bond::To<T, Protocols, Validator> >
     : hierarchy_depth<typename schema<T>::type> {};
 
 
+template <typename T, typename Protocols> struct
+expected_depth<bond::ProjectTo<T, Protocols> >
+    : hierarchy_depth<typename schema<T>::type> {};
+
+
 template <typename Base, typename T>
 inline Base& base_cast(T& obj)
 {
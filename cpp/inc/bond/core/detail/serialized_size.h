@@ -0,0 +1,186 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "double_pass.h"
+
+#include <bond/core/apply.h>
+#include <bond/core/traits.h>
+#include <bond/core/transforms.h>
+#include <bond/stream/output_buffer.h>
+#include <bond/stream/output_counter.h>
+
+namespace bond
+{
+namespace detail
+{
+
+// Writer constructed for the specified protocol version. Writers of protocols
+// with a single version don't take the version argument.
+template <typename Writer, typename Enable = void>
+class VersionedWriter
+    : public Writer
+{
+public:
+    VersionedWriter(typename Writer::Buffer& output, uint16_t version)
+        : Writer(output, version)
+    {}
+};
+
+
+template <typename Writer>
+class VersionedWriter<Writer,
+    typename boost::disable_if<protocol_has_multiple_versions<typename Writer::Reader> >::type>
+    : public Writer
+{
+public:
+    VersionedWriter(typename Writer::Buffer& output, uint16_t version)
+        : Writer(output)
+    {
+        BOOST_VERIFY(version == default_version<typename Writer::Reader>::value);
+    }
+};
+
+
+// Output stream with a single buffer of exactly the specified size. Blobs are
+// always copied instead of chained so that GetBuffer returns the content of
+// the stream without merging.
+class ExactOutputBuffer
+    : public OutputBuffer
+{
+public:
+    explicit ExactOutputBuffer(uint32_t size)
+        : OutputBuffer(size, 0, std::allocator<char>(), 32, 0)
+    {}
+};
+
+
+template <typename Protocols, typename Writer, typename T>
+inline uint32_t CountingPass(const T& obj, uint16_t version)
+{
+    typedef typename get_protocol_writer<typename Writer::Reader, OutputCounter>::type Counter;
+
+    OutputCounter counter;
+    VersionedWriter<Counter> writer(counter, version);
+
+    Apply<Protocols>(Serializer<Counter, Protocols>(writer), obj);
+
+    return counter.GetCount();
+}
+
+
+template <typename Protocols, typename Writer, typename T>
+inline blob SinglePassSerialize(const T& obj, uint16_t version, uint32_t size)
+{
+    ExactOutputBuffer output(size);
+    VersionedWriter<Writer> writer(output, version);
+
+    Apply<Protocols>(Serializer<Writer, Protocols>(writer), obj);
+
+    BOOST_ASSERT(output.GetPosition() == size);
+    return output.GetBuffer();
+}
+
+
+template <typename Protocols, typename Writer, typename T>
+typename boost::disable_if<need_double_pass<Serializer<Writer, Protocols> >, uint32_t>::type
+inline GetSerializedSize(const T& obj, uint16_t version)
+{
+    return CountingPass<Protocols, Writer>(obj, version);
+}
+
+
+template <typename Protocols, typename Writer, typename T>
+typename boost::disable_if<need_double_pass<Serializer<Writer, Protocols> >, blob>::type
+inline SerializeExact(const T& obj, uint16_t version)
+{
+    return SinglePassSerialize<Protocols, Writer>(obj, version, CountingPass<Protocols, Writer>(obj, version));
+}
+
+
+// For protocols using double-pass serialization the count of the pass 0,
+// which includes the encoded struct lengths, is the size of the payload.
+template <typename Protocols, typename Writer>
+class Pass0Counter
+{
+    typedef typename get_protocol_writer<typename Writer::Reader, OutputCounter>::type Counter;
+
+public:
+    explicit Pass0Counter(uint16_t version)
+        : _writer(_unused, version),
+          _pass0(_counter, static_cast<Counter&>(_writer))
+    {}
+
+    bool NeedPass0()
+    {
+        return _writer.NeedPass0();
+    }
+
+    template <typename T>
+    uint32_t Apply(const T& obj)
+    {
+        bond::Apply<Protocols>(Serializer<typename Writer::Pass0, Protocols>(_pass0), obj);
+        return _counter.GetCount();
+    }
+
+    typename Writer::Pass0& GetPass0()
+    {
+        return _pass0;
+    }
+
+private:
+    OutputCounter _unused;
+    VersionedWriter<Counter> _writer;
+    typename Writer::Pass0::Buffer _counter;
+    typename Writer::Pass0 _pass0;
+};
+
+
+template <typename Protocols, typename Writer, typename T>
+typename boost::enable_if<need_double_pass<Serializer<Writer, Protocols> >, uint32_t>::type
+inline GetSerializedSize(const T& obj, uint16_t version)
+{
+    Pass0Counter<Protocols, Writer> pass0(version);
+
+    if (pass0.NeedPass0())
+    {
+        return pass0.Apply(obj);
+    }
+    else
+    {
+        return CountingPass<Protocols, Writer>(obj, version);
+    }
+}
+
+
+// The lengths recorded by the pass 0 used to compute the size are reused by
+// the pass 1, so that the exact allocation doesn't cost an extra pass.
+template <typename Protocols, typename Writer, typename T>
+typename boost::enable_if<need_double_pass<Serializer<Writer, Protocols> >, blob>::type
+inline SerializeExact(const T& obj, uint16_t version)
+{
+    Pass0Counter<Protocols, Writer> pass0(version);
+
+    if (!pass0.NeedPass0())
+    {
+        return SinglePassSerialize<Protocols, Writer>(obj, version, CountingPass<Protocols, Writer>(obj, version));
+    }
+
+    const uint32_t size = pass0.Apply(obj);
+
+    ExactOutputBuffer output(size);
+    VersionedWriter<Writer> writer(output, version);
+
+    auto pass1 = writer.WithPass0(pass0.GetPass0());
+    Apply<Protocols>(Serializer<Writer, Protocols>(writer), obj);
+
+    BOOST_ASSERT(output.GetPosition() == size);
+    return output.GetBuffer();
+}
+
+} // namespace detail
+
+} // namespace bond
@@ -24,6 +24,16 @@ typename boost::enable_if_c<is_list_container<X>::value
                          && is_element_matching<T, X>::value>::type
 inline DeserializeElements(X& var, const T& element, uint32_t size);
 
+template <typename Protocols, typename X, typename T, typename Reader>
+typename boost::enable_if_c<is_contiguous_list_container<X>::value
+                         && std::is_same<typename element_type<X>::type, T>::value
+                         && implements_array_read<Reader, T>::value>::type
+inline DeserializeElements(X& var, const value<T, Reader&>& element, uint32_t size);
+
+template <typename Protocols, typename A, typename Reader>
+typename boost::enable_if<implements_array_read<Reader, bool> >::type
+inline DeserializeElements(std::vector<bool, A>& var, const value<bool, Reader&>& element, uint32_t size);
+
 template <typename Protocols, typename X, typename T>
 typename boost::enable_if<is_matching<T, X> >::type
 inline DeserializeElements(nullable<X>& var, const T& element, uint32_t size);
@@ -402,6 +402,29 @@ private:
     }
 
 
+    template <typename T, typename Protocols>
+    bool UnknownField(uint16_t, BondDataType type, const ProjectTo<T, Protocols>&)
+    {
+        _input.Skip(type);
+        return false;
+    }
+
+
+    template <typename T, typename Protocols>
+    bool UnknownField(uint16_t, BondDataType type, const MapTo<T, Protocols>&)
+    {
+        _input.Skip(type);
+        return false;
+    }
+
+
+    bool UnknownField(uint16_t, BondDataType type, const Null&)
+    {
+        _input.Skip(type);
+        return false;
+    }
+
+
     template <typename Transform>
     bool UnknownField(uint16_t id, BondDataType type, const Transform& transform)
     {
@@ -63,6 +63,18 @@ require_modify_element<std::vector<bool, A> >
     : std::true_type {};
 
 
+// is_contiguous_list_container<std::vector<T, A> >
+template <typename T, typename A> struct
+is_contiguous_list_container<std::vector<T, A> >
+    : std::true_type {};
+
+
+// is_contiguous_list_container<std::vector<bool, A> >
+template <typename A> struct
+is_contiguous_list_container<std::vector<bool, A> >
+    : std::false_type {};
+
+
 // is_set_container<std::set<T, C, A> >
 template <typename T, typename C, typename A> struct
 is_set_container<std::set<T, C, A> >
@@ -182,6 +194,23 @@ resize_list(T& list, uint32_t size)
 }
 
 
+// container_data
+template <typename T, typename A>
+inline
+T* container_data(std::vector<T, A>& list)
+{
+    return list.data();
+}
+
+
+template <typename T, typename A>
+inline
+const T* container_data(const std::vector<T, A>& list)
+{
+    return list.data();
+}
+
+
 // modify_element
 template <typename A, typename F>
 inline
@@ -154,6 +154,44 @@ is_reader<Input, T, typename boost::enable_if<std::is_class<typename Input::Pars
     : std::true_type {};
 
 
+// implements_array_read
+template <typename Reader, typename T, typename Enable = void> struct
+implements_array_read
+    : std::false_type {};
+
+
+// Read(T*, uint32_t) is an optional protocol reader method which reads
+// a series of values of type T into an array in one call.
+template <typename Reader, typename T> struct
+implements_array_read<Reader, T,
+#ifdef BOND_NO_SFINAE_EXPR
+    typename boost::enable_if<check_method<void (Reader::*)(T*, uint32_t), &Reader::Read> >::type>
+#else
+    detail::mpl::void_t<decltype(std::declval<Reader>().Read(
+        std::declval<T*>(), std::declval<uint32_t>()))>>
+#endif
+    : std::true_type {};
+
+
+// implements_array_write
+template <typename Writer, typename T, typename Enable = void> struct
+implements_array_write
+    : std::false_type {};
+
+
+// Write(const T*, uint32_t) is an optional protocol writer method which writes
+// a series of values of type T from an array in one call.
+template <typename Writer, typename T> struct
+implements_array_write<Writer, T,
+#ifdef BOND_NO_SFINAE_EXPR
+    typename boost::enable_if<check_method<void (Writer::*)(const T*, uint32_t), &Writer::Write> >::type>
+#else
+    detail::mpl::void_t<decltype(std::declval<Writer>().Write(
+        std::declval<const T*>(), std::declval<uint32_t>()))>>
+#endif
+    : std::true_type {};
+
+
 template <typename T> struct
 buffer_magic
 {
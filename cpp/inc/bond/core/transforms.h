@@ -18,6 +18,10 @@
 
 #include <boost/static_assert.hpp>
 
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
+
 namespace bond
 {
 
@@ -32,6 +36,16 @@ namespace detail
     template <typename T, typename Schema, typename Transform>
     class _Parser;
 
+    // Contiguous list which can be written using Write(const T*, uint32_t)
+    // method of the protocol writer.
+    template <typename Writer, typename T, typename Enable = void> struct
+    is_array_writable
+        : std::false_type {};
+
+    template <typename Writer, typename T> struct
+    is_array_writable<Writer, T, typename boost::enable_if<is_contiguous_list_container<T> >::type>
+        : implements_array_write<Writer, typename element_type<T>::type> {};
+
 } // namespace detail
 
 
@@ -262,7 +276,8 @@ private:
 
     // container value
     template <typename T>
-    typename boost::enable_if<is_container<T> >::type
+    typename boost::enable_if_c<is_container<T>::value
+                             && !detail::is_array_writable<Writer, T>::value>::type
     Write(const T& value) const
     {
         _output.WriteContainerBegin(container_size(value), get_type_id<typename element_type<T>::type>::value);
@@ -275,6 +290,49 @@ private:
         _output.WriteContainerEnd();
     }
 
+    // contiguous list of basic type values which the writer can write in one call
+    template <typename T>
+    typename boost::enable_if<detail::is_array_writable<Writer, T> >::type
+    Write(const T& value) const
+    {
+        const uint32_t size = container_size(value);
+
+        _output.WriteContainerBegin(size, get_type_id<typename element_type<T>::type>::value);
+
+        if (size)
+        {
+            _output.Write(container_data(value), size);
+        }
+
+        _output.WriteContainerEnd();
+    }
+
+    // vector<bool> written in chunks
+    template <typename A>
+    typename boost::enable_if<implements_array_write<Writer, bool> >::type
+    Write(const std::vector<bool, A>& value) const
+    {
+        uint32_t size = container_size(value);
+
+        _output.WriteContainerBegin(size, get_type_id<bool>::value);
+
+        const uint32_t chunk_size = 256;
+        bool chunk[chunk_size];
+
+        for (typename std::vector<bool, A>::const_iterator it = value.begin(); size != 0;)
+        {
+            const uint32_t count = (std::min)(size, chunk_size);
+
+            std::copy(it, it + count, chunk);
+            _output.Write(static_cast<const bool*>(chunk), count);
+
+            it += count;
+            size -= count;
+        }
+
+        _output.WriteContainerEnd();
+    }
+
 
     // blob
     void Write(const blob& value) const
@@ -599,6 +657,7 @@ private:
         }
     }
 
+protected:
     BOND_NORETURN void UnexpectedStructStopException() const
     {
         // Force instantiation of template statics
@@ -613,6 +672,119 @@ private:
 };
 
 
+/// @brief Set of field ids to deserialize using ProjectTo
+class FieldSet
+{
+public:
+    FieldSet()
+    {}
+
+    FieldSet(std::initializer_list<uint16_t> ids)
+        : _ids(ids)
+    {
+        std::sort(_ids.begin(), _ids.end());
+    }
+
+    template <typename InputIterator>
+    FieldSet(InputIterator first, InputIterator last)
+        : _ids(first, last)
+    {
+        std::sort(_ids.begin(), _ids.end());
+    }
+
+    bool Contains(uint16_t id) const
+    {
+        return std::binary_search(_ids.begin(), _ids.end(), id);
+    }
+
+private:
+    std::vector<uint16_t> _ids;
+};
+
+
+namespace detail
+{
+
+// Projections don't validate required fields, which are left
+// default-initialized when they are not selected.
+class NullValidator
+{
+protected:
+    void Begin() const
+    {}
+
+    template <typename T>
+    void Validate() const
+    {}
+};
+
+} // namespace detail
+
+
+//
+// ProjectTo<T> is a To<T> transform which deserializes only the fields with
+// ids in the specified FieldSet. The values of other fields are not consumed,
+// which makes the parser skip them using the protocol reader, and the fields
+// are left default-initialized. The ids select fields of T as well as of its
+// base structs; fields of nested structs are deserialized entirely.
+//
+template <typename T, typename Protocols>
+class ProjectTo
+    : public To<T, Protocols, detail::NullValidator>
+{
+    typedef To<T, Protocols, detail::NullValidator> ToT;
+
+public:
+    ProjectTo(T& var, const FieldSet& fields)
+        : ToT(var),
+          _fields(fields)
+    {}
+
+    template <typename X>
+    bool Base(const X& value) const
+    {
+        return AssignToBase(value);
+    }
+
+    template <typename X>
+    bool Field(uint16_t id, const Metadata& metadata, const X& value) const
+    {
+        return _fields.Contains(id) && ToT::Field(id, metadata, value);
+    }
+
+    template <typename FieldT, typename X>
+    bool Field(const FieldT& field, const X& value) const
+    {
+        return _fields.Contains(FieldT::id) && ToT::Field(field, value);
+    }
+
+private:
+    template <typename X, typename U = T>
+    typename boost::enable_if<has_base<U>, bool>::type
+    AssignToBase(const X& value) const
+    {
+        bool done = Apply<Protocols>(
+            ProjectTo<typename schema<T>::type::base, Protocols>(this->_var, _fields), value);
+
+        if (done)
+        {
+            this->UnexpectedStructStopException();
+        }
+
+        return false;
+    }
+
+    template <typename X, typename U = T>
+    typename boost::disable_if<has_base<U>, bool>::type
+    AssignToBase(const X& /*value*/) const
+    {
+        return false;
+    }
+
+    const FieldSet& _fields;
+};
+
+
 struct Mapping;
 
 typedef std::vector<uint16_t> Path;
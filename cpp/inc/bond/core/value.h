@@ -10,6 +10,8 @@
 
 #include <boost/static_assert.hpp>
 
+#include <algorithm>
+
 namespace bond
 {
 
@@ -259,6 +261,15 @@ public:
     }
 
 
+    // deserialize series of values to an array
+    template <typename Protocols = BuiltInProtocols>
+    void Deserialize(T* var, uint32_t size) const
+    {
+        _skip = false;
+        _input.Read(var, size);
+    }
+
+
     // deserialize the value and cast it to a variable of a matching non-string type
     template <typename Protocols = BuiltInProtocols, typename X>
     typename boost::enable_if_c<is_matching_basic<T, X>::value && !is_string_type<T>::value>::type
@@ -648,6 +659,43 @@ inline DeserializeElements(X& var, const T& element, uint32_t size)
 }
 
 
+// Read elements of a contiguous list of basic type for protocols which
+// implement bulk read of arrays
+template <typename Protocols, typename X, typename T, typename Reader>
+typename boost::enable_if_c<is_contiguous_list_container<X>::value
+                         && std::is_same<typename element_type<X>::type, T>::value
+                         && implements_array_read<Reader, T>::value>::type
+inline DeserializeElements(X& var, const value<T, Reader&>& element, uint32_t size)
+{
+    resize_list(var, size);
+
+    if (size)
+        element.template Deserialize<Protocols>(container_data(var), size);
+}
+
+
+// Read elements of vector<bool> in chunks for protocols which implement
+// bulk read of arrays
+template <typename Protocols, typename A, typename Reader>
+typename boost::enable_if<implements_array_read<Reader, bool> >::type
+inline DeserializeElements(std::vector<bool, A>& var, const value<bool, Reader&>& element, uint32_t size)
+{
+    resize_list(var, size);
+
+    const uint32_t chunk_size = 256;
+    bool chunk[chunk_size];
+
+    for (typename std::vector<bool, A>::iterator it = var.begin(); size != 0;)
+    {
+        const uint32_t count = (std::min)(size, chunk_size);
+
+        element.template Deserialize<Protocols>(chunk, count);
+        it = std::copy(chunk, chunk + count, it);
+        size -= count;
+    }
+}
+
+
 template <typename Protocols, typename X, typename T>
 typename boost::enable_if<is_matching<T, X> >::type
 inline DeserializeElements(nullable<X>& var, const T& element, uint32_t size)
@@ -0,0 +1,295 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include <boost/assert.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace bond { namespace ext
+{
+    /// @brief Thread-safe pool of memory blocks.
+    ///
+    /// Blocks are grouped in size classes, four per power of two, so that
+    /// a request is rounded up by at most 25%. Released blocks are kept for
+    /// reuse as long as the total size of the pooled blocks doesn't exceed
+    /// the configured cap, otherwise they are freed. Requests larger than the
+    /// largest size class bypass the pool.
+    ///
+    /// The pool is usually used through \ref pooled_allocator, e.g. with
+    /// \c bond::OutputMemoryStream<bond::ext::pooled_allocator<char>> the
+    /// buffers of the stream return to the pool when the last blob
+    /// referencing them is released.
+    class buffer_pool
+    {
+    public:
+        /// @brief Constructs a pool.
+        ///
+        /// @param max_pooled_bytes the maximum total size of the blocks
+        /// kept in the pool for reuse.
+        ///
+        /// @param max_block_size the size of the largest pooled block.
+        explicit buffer_pool(
+            std::size_t max_pooled_bytes = 64 * 1024 * 1024,
+            std::size_t max_block_size = 16 * 1024 * 1024)
+            : _max_pooled_bytes{ max_pooled_bytes },
+              _class_count{ size_class_index(max_block_size) + 1 },
+              _free_lists{ new std::vector<void*>[_class_count] },
+              _pooled_bytes{ 0 },
+              _hits{ 0 },
+              _misses{ 0 }
+        {}
+
+        buffer_pool(const buffer_pool&) = delete;
+        buffer_pool& operator=(const buffer_pool&) = delete;
+
+        ~buffer_pool()
+        {
+            clear();
+        }
+
+        /// @brief Returns the process-wide pool with default settings.
+        ///
+        /// @remarks The pool is never destroyed so that memory can be
+        /// returned to it at any time, including during static destruction.
+        static buffer_pool& shared()
+        {
+            static buffer_pool* const pool = new buffer_pool;
+            return *pool;
+        }
+
+        /// @brief Allocates a block of at least the specified size.
+        void* allocate(std::size_t size)
+        {
+            const std::size_t index = size_class_index(size);
+
+            if (index < _class_count)
+            {
+                {
+                    std::lock_guard<std::mutex> lock{ _mutex };
+                    std::vector<void*>& free_list = _free_lists[index];
+
+                    if (!free_list.empty())
+                    {
+                        void* block = free_list.back();
+                        free_list.pop_back();
+                        _pooled_bytes -= class_size(index);
+                        _hits.fetch_add(1, std::memory_order_relaxed);
+                        return block;
+                    }
+                }
+
+                size = class_size(index);
+            }
+
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return ::operator new(size);
+        }
+
+        /// @brief Returns a block allocated with the specified size to the pool.
+        void deallocate(void* block, std::size_t size) BOND_NOEXCEPT
+        {
+            const std::size_t index = size_class_index(size);
+
+            if (index < _class_count)
+            {
+                const std::size_t block_size = class_size(index);
+                std::lock_guard<std::mutex> lock{ _mutex };
+
+                if (_pooled_bytes + block_size <= _max_pooled_bytes)
+                {
+                    try
+                    {
+                        _free_lists[index].push_back(block);
+                        _pooled_bytes += block_size;
+                        return;
+                    }
+                    catch (const std::bad_alloc&)
+                    {
+                        // Free the block below
+                    }
+                }
+            }
+
+            ::operator delete(block);
+        }
+
+        /// @brief Frees all blocks kept in the pool.
+        void clear() BOND_NOEXCEPT
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+
+            for (std::size_t index = 0; index < _class_count; ++index)
+            {
+                for (void* block : _free_lists[index])
+                {
+                    ::operator delete(block);
+                }
+
+                _free_lists[index].clear();
+            }
+
+            _pooled_bytes = 0;
+        }
+
+        /// @brief Returns the total size of the blocks kept in the pool.
+        std::size_t pooled_bytes() const
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            return _pooled_bytes;
+        }
+
+        /// @brief Returns the number of allocations served from the pool.
+        std::uint64_t hits() const BOND_NOEXCEPT
+        {
+            return _hits.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Returns the number of allocations which had to allocate
+        /// a new block, including those which bypassed the pool.
+        std::uint64_t misses() const BOND_NOEXCEPT
+        {
+            return _misses.load(std::memory_order_relaxed);
+        }
+
+    private:
+        // The smallest size class is 2^c_min_shift bytes
+        static const std::size_t c_min_shift = 6;
+
+        static std::size_t size_class_index(std::size_t size) BOND_NOEXCEPT
+        {
+            if (size <= (std::size_t(1) << c_min_shift))
+            {
+                return 0;
+            }
+
+            // Find the power of two range (2^shift, 2^(shift + 1)] of the size
+            // and the quarter of the range which contains it.
+            std::size_t shift = c_min_shift;
+
+            while ((size - 1) >> (shift + 1))
+            {
+                ++shift;
+            }
+
+            const std::size_t quarter = ((size - 1) >> (shift - 2)) & 3;
+
+            return (shift - c_min_shift) * 4 + quarter + 1;
+        }
+
+        static std::size_t class_size(std::size_t index) BOND_NOEXCEPT
+        {
+            if (index == 0)
+            {
+                return std::size_t(1) << c_min_shift;
+            }
+
+            const std::size_t shift = (index - 1) / 4 + c_min_shift;
+            const std::size_t quarter = (index - 1) % 4;
+
+            return (std::size_t(1) << shift) + ((quarter + 1) << (shift - 2));
+        }
+
+        const std::size_t _max_pooled_bytes;
+        const std::size_t _class_count;
+        std::unique_ptr<std::vector<void*>[]> _free_lists;
+        std::size_t _pooled_bytes;
+        mutable std::mutex _mutex;
+        std::atomic<std::uint64_t> _hits;
+        std::atomic<std::uint64_t> _misses;
+    };
+
+
+    /// @brief STL-compatible allocator drawing memory from a \ref buffer_pool.
+    ///
+    /// @remarks Copies of the allocator, including rebound ones, use the same
+    /// pool. When constructed from a %std::shared_ptr the pool is kept alive
+    /// as long as any of the copies exists, otherwise the pool must outlive
+    /// all memory allocated from it.
+    template <typename T = char>
+    class pooled_allocator
+    {
+    public:
+        using value_type = T;
+
+        /// @brief Constructs an allocator using the process-wide pool.
+        pooled_allocator() BOND_NOEXCEPT
+            : _pool{ &buffer_pool::shared() }
+        {}
+
+        /// @brief Constructs an allocator using the specified pool.
+        explicit pooled_allocator(buffer_pool& pool) BOND_NOEXCEPT
+            : _pool{ &pool }
+        {}
+
+        /// @brief Constructs an allocator sharing ownership of the specified pool.
+        explicit pooled_allocator(std::shared_ptr<buffer_pool> pool) BOND_NOEXCEPT
+            : _pool{ pool.get() },
+              _owner{ std::move(pool) }
+        {
+            BOOST_ASSERT(_pool);
+        }
+
+        /// @brief Converts from an allocator of a different type.
+        template <typename U>
+        pooled_allocator(const pooled_allocator<U>& other) BOND_NOEXCEPT
+            : _pool{ other._pool },
+              _owner{ other._owner }
+        {}
+
+        T* allocate(std::size_t n)
+        {
+            if (n > (std::numeric_limits<std::size_t>::max)() / sizeof(T))
+            {
+                throw std::bad_alloc{};
+            }
+
+            return static_cast<T*>(_pool->allocate(n * sizeof(T)));
+        }
+
+        void deallocate(T* ptr, std::size_t n) BOND_NOEXCEPT
+        {
+            _pool->deallocate(ptr, n * sizeof(T));
+        }
+
+        buffer_pool& get_pool() const BOND_NOEXCEPT
+        {
+            return *_pool;
+        }
+
+    private:
+        template <typename U>
+        friend class pooled_allocator;
+
+        buffer_pool* _pool;
+        std::shared_ptr<buffer_pool> _owner;
+    };
+
+
+    template <typename T, typename U>
+    inline bool operator==(
+        const pooled_allocator<T>& a1,
+        const pooled_allocator<U>& a2) BOND_NOEXCEPT
+    {
+        return &a1.get_pool() == &a2.get_pool();
+    }
+
+    template <typename T, typename U>
+    inline bool operator!=(
+        const pooled_allocator<T>& a1,
+        const pooled_allocator<U>& a2) BOND_NOEXCEPT
+    {
+        return !(a1 == a2);
+    }
+
+} } // namespace bond::ext
@@ -6,6 +6,7 @@
 #include <bond/core/config.h>
 
 #include "exception.h"
+#include "scheduler.h"
 
 #if defined (__APPLE__)
     // Work-around: 'OSMemoryBarrier' has been explicitly marked deprecated
@@ -23,6 +24,7 @@
 #endif
 
 #include <boost/thread/scoped_thread.hpp>
+#include <boost/version.hpp>
 
 #include <thread>
 #include <vector>
@@ -69,7 +71,11 @@ namespace bond { namespace ext { namespace grpc
         template <typename Callback>
         void operator()(Callback&& callback)
         {
+#if BOOST_VERSION >= 106600
+            boost::asio::post(*_service, std::forward<Callback>(callback));
+#else
             _service->post(std::forward<Callback>(callback));
+#endif
         }
 
         /// @brief Get the underlying boost::asio::io_service
@@ -94,4 +100,12 @@ namespace bond { namespace ext { namespace grpc
         std::shared_ptr<service> _service{ std::make_shared<service>() };
     };
 
+#if BOOST_VERSION >= 106600
+    // Only the boost::asio::post added in Boost 1.66 accepts move-only
+    // handlers.
+    template <>
+    struct is_task_scheduler<basic_thread_pool>
+        : std::true_type {};
+#endif
+
 } } } // namespace bond::ext::grpc
@@ -7,10 +7,12 @@
 
 #include "io_manager_tag.h"
 #include "serialization.h"
+#include "streaming_call_impl.h"
 
 #include <bond/core/bonded.h>
 #include <bond/ext/grpc/io_manager.h>
 #include <bond/ext/grpc/scheduler.h>
+#include <bond/ext/grpc/streaming_call.h>
 #include <bond/ext/grpc/unary_call_result.h>
 
 #ifdef _MSC_VER
@@ -74,9 +76,11 @@ namespace bond { namespace ext { namespace grpc { namespace detail
             Method();
         };
 #endif
-        Method make_method(const char* name) const
+        Method make_method(
+            const char* name,
+            ::grpc::internal::RpcMethod::RpcType type = ::grpc::internal::RpcMethod::NORMAL_RPC) const
         {
-            return Method{ name, ::grpc::internal::RpcMethod::NORMAL_RPC, _channel };
+            return Method{ name, type, _channel };
         }
 
         template <typename Response = void, typename Request = Void>
@@ -132,9 +136,145 @@ namespace bond { namespace ext { namespace grpc { namespace detail
             return dispatch<Response>(method, std::move(context), bonded<Request>{ boost::ref(request) });
         }
 
+        /// @brief Starts a call to a server-streaming method.
+        ///
+        /// @param onMessage invoked for each message from the service. The
+        /// next message is only read once it has returned.
+        ///
+        /// @param onFinish invoked with the status of the call, after the
+        /// last message.
+        template <typename Response, typename Request = Void>
+        void dispatch_server_streaming(
+            const ::grpc::internal::RpcMethod& method,
+            std::shared_ptr<::grpc::ClientContext> context,
+            const std::function<void(bonded<Response>)>& onMessage,
+            const std::function<void(const ::grpc::Status&)>& onFinish,
+            const bonded<Request>& request)
+        {
+            auto call = start_stream(method, std::move(context), make_message_callback(onMessage), make_finish_callback(onFinish));
+            call->Write(Serialize(request), {});
+            call->WritesDone();
+        }
+
+        template <typename Response, typename Request = Void>
+        void dispatch_server_streaming(
+            const ::grpc::internal::RpcMethod& method,
+            std::shared_ptr<::grpc::ClientContext> context,
+            const std::function<void(bonded<Response>)>& onMessage,
+            const std::function<void(const ::grpc::Status&)>& onFinish,
+            const Request& request = {})
+        {
+            dispatch_server_streaming(method, std::move(context), onMessage, onFinish, bonded<Request>{ boost::ref(request) });
+        }
+
+        /// @brief Starts a call to a client-streaming method.
+        ///
+        /// @param cb invoked with the response, once the service has
+        /// received all the messages and finished the call.
+        ///
+        /// @return the writer to stream the messages to the service with.
+        template <typename Request, typename Response>
+        client_stream_writer<Request> dispatch_client_streaming(
+            const ::grpc::internal::RpcMethod& method,
+            std::shared_ptr<::grpc::ClientContext> context,
+            const std::function<void(unary_call_result<Response>)>& cb)
+        {
+            client_stream_impl::finish_callback onFinish;
+
+            if (cb)
+            {
+                onFinish = std::bind(
+                    [](const std::function<void(unary_call_result<Response>)>& callback,
+                        const ::grpc::ByteBuffer& response,
+                        const ::grpc::Status& status,
+                        std::shared_ptr<::grpc::ClientContext> ctx)
+                    {
+                        callback(unary_call_result<Response>{ response, status, std::move(ctx) });
+                    },
+                    cb,
+                    std::placeholders::_1,
+                    std::placeholders::_2,
+                    std::placeholders::_3);
+            }
+
+            return client_stream_writer<Request>{
+                start_stream(method, std::move(context), {}, std::move(onFinish)) };
+        }
+
+        /// @brief Starts a call to a bidirectional streaming method.
+        ///
+        /// @param onMessage invoked for each message from the service. The
+        /// next message is only read once it has returned.
+        ///
+        /// @param onFinish invoked with the status of the call, after the
+        /// last message.
+        ///
+        /// @return the writer to stream the messages to the service with.
+        template <typename Request, typename Response>
+        client_stream_writer<Request> dispatch_bidi_streaming(
+            const ::grpc::internal::RpcMethod& method,
+            std::shared_ptr<::grpc::ClientContext> context,
+            const std::function<void(bonded<Response>)>& onMessage,
+            const std::function<void(const ::grpc::Status&)>& onFinish)
+        {
+            return client_stream_writer<Request>{
+                start_stream(method, std::move(context), make_message_callback(onMessage), make_finish_callback(onFinish)) };
+        }
+
     private:
+        template <typename Response>
         class unary_call_data;
 
+        boost::intrusive_ptr<client_stream_impl> start_stream(
+            const ::grpc::internal::RpcMethod& method,
+            std::shared_ptr<::grpc::ClientContext> context,
+            client_stream_impl::message_callback onMessage,
+            client_stream_impl::finish_callback onFinish)
+        {
+            boost::intrusive_ptr<client_stream_impl> call{ new client_stream_impl{
+                _ioManager->shared_cq(),
+                _channel,
+                context ? std::move(context) : std::make_shared<::grpc::ClientContext>(),
+                _scheduler,
+                std::move(onMessage),
+                std::move(onFinish) } };
+
+            call->Start(method);
+            return call;
+        }
+
+        template <typename Response>
+        static client_stream_impl::message_callback make_message_callback(
+            const std::function<void(bonded<Response>)>& onMessage)
+        {
+            BOOST_ASSERT(onMessage);
+
+            return std::bind(
+                [](const std::function<void(bonded<Response>)>& callback, const ::grpc::ByteBuffer& buffer)
+                {
+                    callback(Deserialize<Response>(buffer));
+                },
+                onMessage,
+                std::placeholders::_1);
+        }
+
+        static client_stream_impl::finish_callback make_finish_callback(
+            const std::function<void(const ::grpc::Status&)>& onFinish)
+        {
+            if (!onFinish)
+            {
+                return {};
+            }
+
+            return std::bind(
+                [](const std::function<void(const ::grpc::Status&)>& callback, const ::grpc::Status& status)
+                {
+                    callback(status);
+                },
+                onFinish,
+                std::placeholders::_2);
+        }
+
         std::shared_ptr<::grpc::ChannelInterface> _channel;
         std::shared_ptr<io_manager> _ioManager;
         Scheduler _scheduler;
@@ -143,12 +283,15 @@ namespace bond { namespace ext { namespace grpc { namespace detail
 
     /// @brief Implementation class that hold the state associated with
     /// outgoing unary calls.
+    ///
+    /// The callback scheduled once the response has been received only
+    /// holds a reference to this object, so that it fits in a \ref task.
+    template <typename Response>
     class client::unary_call_data
-        : public boost::intrusive_ref_counter<unary_call_data>,
+        : public boost::intrusive_ref_counter<unary_call_data<Response>>,
           io_manager_tag
     {
     public:
-        template <typename Response>
         unary_call_data(
             const ::grpc::internal::RpcMethod& method,
             const ::grpc::ByteBuffer& requestBuffer,
@@ -171,47 +314,32 @@ namespace bond { namespace ext { namespace grpc { namespace detail
               _scheduler(scheduler),
               _responseBuffer(),
               _status(),
+              _callback(cb),
               _self(this)
         {
             BOOST_ASSERT(_scheduler);
 
-            if (cb)
-            {
-                _invoke = std::bind(&unary_call_data::invoke<Response>, this, cb);
-            }
-
             auto self = _self; // Make sure `this` will outlive the below call.
             _responseReader->Finish(&_responseBuffer, &_status, tag());
         }
 
     private:
-        template <typename Response>
-        void invoke(const std::function<void(unary_call_result<Response>)>& callback)
+        void deliver()
         {
-            // TODO: Use lambda with move-capture when allowed to use C++14.
-            _scheduler(std::bind(
-                [](decltype(callback)& cb,
-                    ::grpc::ByteBuffer& responseBuffer,
-                    ::grpc::Status& status,
-                    std::shared_ptr<::grpc::ClientContext>& context)
-                {
-                    cb(unary_call_result<Response>{ std::move(responseBuffer), status, std::move(context) });
-                },
-                callback,
-                std::move(_responseBuffer),
-                std::move(_status),
-                std::move(_context)));
+            _callback(unary_call_result<Response>{ _responseBuffer, _status, std::move(_context) });
         }
 
         /// @brief Invoked after the response has been received.
         void invoke(bool ok) override
         {
-            if (ok && _invoke)
+            // The scheduled callback, if any, takes over the reference to
+            // ourselves, so that we may be gone once it has been scheduled.
+            boost::intrusive_ptr<unary_call_data> self = std::move(_self);
+
+            if (ok && _callback)
             {
-                _invoke();
+                _scheduler(std::bind(&unary_call_data::deliver, std::move(self)));
             }
-
-            _self.reset();
         }
 
         /// The completion port to post IO operations to.
@@ -228,8 +356,8 @@ namespace bond { namespace ext { namespace grpc { namespace detail
         /*::grpc::*/ByteBuffer _responseBuffer;
         /// @brief The status of the request.
         ::grpc::Status _status;
-        /// @brief Type-erased function to invoke user-callback for a response.
-        std::function<void()> _invoke;
+        /// The user callback to invoke with the response.
+        std::function<void(unary_call_result<Response>)> _callback;
         /// A pointer to ourselves used to keep us alive while waiting to
         /// receive the response.
         boost::intrusive_ptr<unary_call_data> _self;
@@ -243,7 +371,7 @@ namespace bond { namespace ext { namespace grpc { namespace detail
         const std::function<void(unary_call_result<Response>)>& cb,
         const bonded<Request>& request)
     {
-        new unary_call_data{
+        new unary_call_data<Response>{
             method,
             Serialize(request),
             _ioManager->shared_cq(),
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#if defined(_WIN32) || defined(WIN32)
+    // Keep the macros and declarations this header pulls in to a minimum, and
+    // restore the configuration of the including code afterwards.
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+        #define BOND_CPU_AFFINITY_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+        #define BOND_CPU_AFFINITY_NOMINMAX
+    #endif
+
+    #include <windows.h>
+
+    #ifdef BOND_CPU_AFFINITY_LEAN_AND_MEAN
+        #undef WIN32_LEAN_AND_MEAN
+        #undef BOND_CPU_AFFINITY_LEAN_AND_MEAN
+    #endif
+    #ifdef BOND_CPU_AFFINITY_NOMINMAX
+        #undef NOMINMAX
+        #undef BOND_CPU_AFFINITY_NOMINMAX
+    #endif
+#elif defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace bond { namespace ext { namespace grpc { namespace detail {
+
+    /// @brief Restricts the calling thread to run on the specified CPU.
+    ///
+    /// @return false if the CPU doesn't exist or if the platform doesn't
+    /// support pinning threads, in which case the thread keeps its
+    /// affinity.
+    inline bool pin_current_thread(unsigned int cpu)
+    {
+#if defined(_WIN32) || defined(WIN32)
+        if (cpu >= sizeof(DWORD_PTR) * 8)
+        {
+            return false;
+        }
+
+        return ::SetThreadAffinityMask(::GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+        if (cpu >= CPU_SETSIZE)
+        {
+            return false;
+        }
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+
+        return ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+} } } } // namespace bond::ext::grpc::detail
@@ -107,20 +107,26 @@ namespace bond { namespace ext { namespace grpc { namespace detail
             throw GrpcException{ status };
         }
 
-        const auto length = buffer.Length();
-        auto buff = boost::make_shared_noinit<char[]>(length);
+        // Blobs referencing the memory of the slices, each keeping its slice
+        // alive for as long as the blob is.
+        boost::container::small_vector<blob, 8> blobs;
+        blobs.reserve(slices.size());
 
-        char* dest = buff.get();
         for (auto& s : slices)
         {
-            std::memcpy(dest, s.begin(), s.size());
-            dest += s.size();
+            const auto size = static_cast<uint32_t>(s.size());
+            auto slice = boost::make_shared<::grpc::Slice>(std::move(s));
+
+            blobs.emplace_back(
+                boost::shared_ptr<const char[]>{ slice, reinterpret_cast<const char*>(slice->begin()) },
+                size);
         }
 
-        // TODO: create a Bond input stream over ::grpc::ByteBuffer to avoid
-        // having to make this copy into a blob.
-        blob data{ buff, static_cast<uint32_t>(length) };
-        return InputBuffer{ data };
+        // bonded<T> values exposed by the gRPC APIs use the built-in protocols
+        // over InputBuffer, which requires contiguous memory. The memory of the
+        // slice is used directly when the message is in a single slice and is
+        // only copied when it spans multiple slices.
+        return InputBuffer{ merge(blobs.begin(), blobs.end()) };
     }
 
     template <typename T>
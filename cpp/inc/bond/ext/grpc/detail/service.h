@@ -9,6 +9,7 @@
 
 #include <bond/ext/grpc/abstract_service.h>
 #include <bond/ext/grpc/scheduler.h>
+#include <bond/ext/grpc/streaming_call.h>
 #include <bond/ext/grpc/unary_call.h>
 
 #ifdef _MSC_VER
@@ -28,9 +29,11 @@
 #include <boost/assert.hpp>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
+#include <algorithm>
 #include <initializer_list>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace bond { namespace ext { namespace grpc
 {
@@ -38,6 +41,22 @@ namespace bond { namespace ext { namespace grpc
 
 namespace detail
 {
+    /// @brief The name and kind of a method of a service.
+    ///
+    /// @note This struct is for use by generated and helper code only.
+    struct method_info
+    {
+        method_info(
+            const char* name,
+            ::grpc::internal::RpcMethod::RpcType type = ::grpc::internal::RpcMethod::NORMAL_RPC)
+            : name{ name },
+              type{ type }
+        {}
+
+        const char* name;
+        ::grpc::internal::RpcMethod::RpcType type;
+    };
+
     /// @brief Base class that all Bond grpc++ services implement.
     ///
     /// @note This class is for use by generated and helper code only.
@@ -46,7 +65,11 @@ namespace detail
     /// which a bond::ext::grpc::server then hosts multiple services.
     class service : public abstract_service, private ::grpc::Service
     {
+        template <typename Request, typename Response>
         class unary_call_data;
+        template <typename Call>
+        class streaming_call_data;
+        class method;
 
     public:
         /// @brief Provides access to the raw ::grpc::Service type.
@@ -70,15 +93,50 @@ namespace detail
             return std::bind(callback, &svc, std::placeholders::_1);
         }
 
-    protected:
-        using Method = unary_call_data;
+        template <typename ServiceT, typename Request, typename Response>
+        std::function<void(server_streaming_call<Request, Response>)>
+        static make_callback(void (ServiceT::*callback)(server_streaming_call<Request, Response>), ServiceT& svc)
+        {
+            BOOST_STATIC_ASSERT(std::is_base_of<service, ServiceT>::value);
+            return std::bind(callback, &svc, std::placeholders::_1);
+        }
 
-        service(const Scheduler& scheduler, std::initializer_list<const char*> methodNames)
+        template <typename ServiceT, typename Request, typename Response>
+        std::function<void(client_streaming_call<Request, Response>)>
+        static make_callback(void (ServiceT::*callback)(client_streaming_call<Request, Response>), ServiceT& svc)
+        {
+            BOOST_STATIC_ASSERT(std::is_base_of<service, ServiceT>::value);
+            return std::bind(callback, &svc, std::placeholders::_1);
+        }
+
+        template <typename ServiceT, typename Request, typename Response>
+        std::function<void(bidi_streaming_call<Request, Response>)>
+        static make_callback(void (ServiceT::*callback)(bidi_streaming_call<Request, Response>), ServiceT& svc)
+        {
+            BOOST_STATIC_ASSERT(std::is_base_of<service, ServiceT>::value);
+            return std::bind(callback, &svc, std::placeholders::_1);
+        }
+
+    protected:
+        using Method = method;
+
+        service(const Scheduler& scheduler, std::initializer_list<method_info> methods)
+            : service{ scheduler, 1u, methods }
+        {}
+
+        /// @param receivesPerMethod the number of receives kept pending for
+        /// each method on each completion queue, i.e. the number of calls to
+        /// a method which can arrive before the first of them is scheduled.
+        service(
+            const Scheduler& scheduler,
+            unsigned int receivesPerMethod,
+            std::initializer_list<method_info> methods)
             : _scheduler{ scheduler },
-              _cq{ nullptr }
+              _receivesPerMethod{ (std::max)(receivesPerMethod, 1u) },
+              _cqs{}
         {
             BOOST_ASSERT(_scheduler);
-            AddMethods(methodNames);
+            AddMethods(methods);
         }
 
     private:
@@ -109,6 +167,9 @@ namespace detail
         ///
         /// @param responseStream pointer to a response stream to populate
         ///
+        /// @param cq the completion queue to receive the call on; one of the
+        /// queues returned by completion_queues
+        ///
         /// @param tag the io_manager_tag to include with the completion queue
         /// notification
         template <typename Request>
@@ -117,85 +178,132 @@ namespace detail
             ::grpc::ServerContext* context,
             Request* request,
             ::grpc::internal::ServerAsyncStreamingInterface* responseStream,
+            ::grpc::ServerCompletionQueue* cq,
             io_manager_tag* tag)
         {
-            BOOST_ASSERT(_cq);
-            RequestAsyncUnary(methodIndex, context, request, responseStream, _cq, _cq, tag);
+            BOOST_ASSERT(cq);
+            RequestAsyncUnary(methodIndex, context, request, responseStream, cq, cq, tag);
         }
 
-        void AddMethods(std::initializer_list<const char*> names)
+        /// @brief Starts the receive process for a streaming method.
+        ///
+        /// @note This method is for use by generated and helper code only.
+        ///
+        /// Same as queue_receive, except that \p request is only populated
+        /// for server-streaming methods, the only kind of streaming methods
+        /// with a single request message.
+        void queue_receive_streaming(
+            ::grpc::internal::RpcMethod::RpcType type,
+            int methodIndex,
+            ::grpc::ServerContext* context,
+            ::grpc::ByteBuffer* request,
+            ::grpc::internal::ServerAsyncStreamingInterface* stream,
+            ::grpc::ServerCompletionQueue* cq,
+            io_manager_tag* tag)
         {
-            for (const char* name : names)
+            BOOST_ASSERT(cq);
+
+            switch (type)
             {
-                BOOST_ASSERT(name);
+                case ::grpc::internal::RpcMethod::SERVER_STREAMING:
+                    RequestAsyncServerStreaming(methodIndex, context, request, stream, cq, cq, tag);
+                    break;
+
+                case ::grpc::internal::RpcMethod::CLIENT_STREAMING:
+                    RequestAsyncClientStreaming(methodIndex, context, stream, cq, cq, tag);
+                    break;
+
+                case ::grpc::internal::RpcMethod::BIDI_STREAMING:
+                    RequestAsyncBidiStreaming(methodIndex, context, stream, cq, cq, tag);
+                    break;
+
+                default:
+                    BOOST_ASSERT_MSG(false, "Not a streaming method");
+                    break;
+            }
+        }
+
+        void AddMethods(std::initializer_list<method_info> methods)
+        {
+            for (const method_info& m : methods)
+            {
+                BOOST_ASSERT(m.name);
 
                 // ownership of the service method is transfered to ::grpc::Service
                 ::grpc::Service::AddMethod(
                     new ::grpc::internal::RpcServiceMethod(
-                        name,
-                        ::grpc::internal::RpcMethod::NORMAL_RPC,
+                        m.name,
+                        m.type,
                         nullptr)); // nullptr indicates async handler
             }
         }
 
-        void SetCompletionQueue(::grpc::ServerCompletionQueue* cq)
+        void SetCompletionQueues(std::vector<::grpc::ServerCompletionQueue*> cqs)
+        {
+            BOOST_ASSERT(_cqs.empty());
+            BOOST_ASSERT(!cqs.empty());
+            _cqs = std::move(cqs);
+        }
+
+        const std::vector<::grpc::ServerCompletionQueue*>& completion_queues() const
+        {
+            return _cqs;
+        }
+
+        unsigned int receives_per_method() const
         {
-            BOOST_ASSERT(!_cq);
-            _cq = cq;
+            return _receivesPerMethod;
         }
 
         Scheduler _scheduler;
-        ::grpc::ServerCompletionQueue* _cq;
+        unsigned int _receivesPerMethod;
+        std::vector<::grpc::ServerCompletionQueue*> _cqs;
     };
 
     /// @brief Implementation class that hold the state associated with
-    /// receiving incoming calls for one method.
+    /// receiving incoming calls for one method on one completion queue.
     ///
-    /// There only needs to be one of these per method in a service, and it can
-    /// be re-used for receiving subsequent calls. A new detail::unary_call_impl
-    /// is created for each individual call to hold the call-specific data. Once
-    /// the invocation of the user callback along with the call-specific data
-    /// has been scheduled, unary_call_data re-enqueues itself to get the next call.
-    class service::unary_call_data : io_manager_tag
+    /// It can be re-used for receiving subsequent calls. A new
+    /// detail::unary_call_impl is created for each individual call to hold
+    /// the call-specific data. Once the invocation of the user callback along
+    /// with the call-specific data has been scheduled, unary_call_data
+    /// re-enqueues itself to get the next call.
+    ///
+    /// The scheduled callback refers to the user callback held here rather
+    /// than copying it, so that it fits in a \ref task.
+    template <typename Request, typename Response>
+    class service::unary_call_data : public io_manager_tag
     {
     public:
-        template <typename Request, typename Response>
         unary_call_data(
             service& service,
             int methodIndex,
+            ::grpc::ServerCompletionQueue* cq,
             const std::function<void(unary_call<Request, Response>)>& cb)
             : _service{ service },
               _methodIndex{ methodIndex },
-              _invoke{ std::bind(&unary_call_data::invoke<Request, Response>, this, cb) },
+              _cq{ cq },
+              _callback{ cb },
               _receivedCall{}
         {
-            BOOST_ASSERT(cb);
+            BOOST_ASSERT(_callback);
             queue_receive();
         }
 
     private:
-        template <typename Request, typename Response>
-        void invoke(const std::function<void(unary_call<Request, Response>)>& callback)
-        {
-            // TODO: Use lambda with move-capture when allowed to use C++14.
-            _service.scheduler()(std::bind(
-                [](const decltype(callback)& cb, boost::intrusive_ptr<unary_call_impl>& receivedCall)
-                {
-                    cb(unary_call<Request, Response>{ std::move(receivedCall) });
-                },
-                callback,
-                queue_receive()));
-        }
-
         void invoke(bool ok) override
         {
             if (ok)
             {
-                BOOST_ASSERT(_invoke);
-                _invoke();
+                _service.scheduler()(std::bind(&unary_call_data::deliver, this, queue_receive()));
             }
         }
 
+        void deliver(boost::intrusive_ptr<unary_call_impl>& receivedCall)
+        {
+            _callback(unary_call<Request, Response>{ std::move(receivedCall) });
+        }
+
         boost::intrusive_ptr<unary_call_impl> queue_receive()
         {
             boost::intrusive_ptr<unary_call_impl> receivedCall{ _receivedCall.release() };
@@ -208,6 +316,7 @@ namespace detail
                 &_receivedCall->context(),
                 &_receivedCall->request_buffer(),
                 &_receivedCall->responder(),
+                _cq,
                 tag());
 
             return receivedCall;
@@ -218,10 +327,175 @@ namespace detail
         /// The index of the method. Method indices correspond to the order in
         /// which they were registered with detail::service::AddMethod
         const int _methodIndex;
-        /// @brief Type-erased function to invoke user-callback for a response.
-        std::function<void()> _invoke;
+        /// The completion queue the calls are received on.
+        ::grpc::ServerCompletionQueue* const _cq;
+        /// The user callback to invoke for each call.
+        std::function<void(unary_call<Request, Response>)> _callback;
         /// Individual state for one specific call to this method.
         std::unique_ptr<unary_call_impl> _receivedCall;
     };
 
+    /// @brief Implementation class that hold the state associated with
+    /// receiving incoming calls for one streaming method on one completion
+    /// queue.
+    ///
+    /// Works like unary_call_data, with a detail::server_stream_impl for
+    /// each individual call.
+    ///
+    /// @tparam Call one of \ref server_streaming_call, \ref
+    /// client_streaming_call or \ref bidi_streaming_call
+    template <typename Call>
+    class service::streaming_call_data : public io_manager_tag
+    {
+    public:
+        streaming_call_data(
+            service& service,
+            ::grpc::internal::RpcMethod::RpcType type,
+            int methodIndex,
+            ::grpc::ServerCompletionQueue* cq,
+            const std::function<void(Call)>& cb)
+            : _service{ service },
+              _type{ type },
+              _methodIndex{ methodIndex },
+              _cq{ cq },
+              _callback{ cb },
+              _receivedCall{}
+        {
+            BOOST_ASSERT(_callback);
+            queue_receive();
+        }
+
+    private:
+        void invoke(bool ok) override
+        {
+            if (ok)
+            {
+                _service.scheduler()(std::bind(&streaming_call_data::deliver, this, queue_receive()));
+            }
+        }
+
+        void deliver(boost::intrusive_ptr<server_stream_impl>& receivedCall)
+        {
+            _callback(Call{ std::move(receivedCall) });
+        }
+
+        boost::intrusive_ptr<server_stream_impl> queue_receive()
+        {
+            boost::intrusive_ptr<server_stream_impl> receivedCall = std::move(_receivedCall);
+
+            // create new state for the next call that will be received
+            _receivedCall.reset(new server_stream_impl{ _service.scheduler() });
+
+            _service.queue_receive_streaming(
+                _type,
+                _methodIndex,
+                &_receivedCall->context(),
+                &_receivedCall->request_buffer(),
+                &_receivedCall->stream(),
+                _cq,
+                tag());
+
+            return receivedCall;
+        }
+
+        /// The service implementing the method.
+        service& _service;
+        /// The kind of streaming method.
+        const ::grpc::internal::RpcMethod::RpcType _type;
+        /// The index of the method.
+        const int _methodIndex;
+        /// The completion queue the calls are received on.
+        ::grpc::ServerCompletionQueue* const _cq;
+        /// The user callback to invoke for each call.
+        std::function<void(Call)> _callback;
+        /// Individual state for one specific call to this method.
+        boost::intrusive_ptr<server_stream_impl> _receivedCall;
+    };
+
+    /// @brief Receives incoming calls for one method of a service.
+    ///
+    /// There only needs to be one of these per method in a service. It keeps
+    /// service::receives_per_method pending receives on each of the
+    /// completion queues of the server, so that calls to the method are
+    /// spread over all the queues and bursts of calls are accepted without
+    /// waiting for each receive to be posted again.
+    ///
+    /// The kind of the method is picked from the type of the callback.
+    class service::method
+    {
+    public:
+        template <typename Request, typename Response>
+        method(
+            service& service,
+            int methodIndex,
+            const std::function<void(unary_call<Request, Response>)>& cb)
+        {
+            add_receives(service, [&](::grpc::ServerCompletionQueue* cq)
+            {
+                return new unary_call_data<Request, Response>{ service, methodIndex, cq, cb };
+            });
+        }
+
+        template <typename Request, typename Response>
+        method(
+            service& service,
+            int methodIndex,
+            const std::function<void(server_streaming_call<Request, Response>)>& cb)
+        {
+            add_streaming_receives(service, ::grpc::internal::RpcMethod::SERVER_STREAMING, methodIndex, cb);
+        }
+
+        template <typename Request, typename Response>
+        method(
+            service& service,
+            int methodIndex,
+            const std::function<void(client_streaming_call<Request, Response>)>& cb)
+        {
+            add_streaming_receives(service, ::grpc::internal::RpcMethod::CLIENT_STREAMING, methodIndex, cb);
+        }
+
+        template <typename Request, typename Response>
+        method(
+            service& service,
+            int methodIndex,
+            const std::function<void(bidi_streaming_call<Request, Response>)>& cb)
+        {
+            add_streaming_receives(service, ::grpc::internal::RpcMethod::BIDI_STREAMING, methodIndex, cb);
+        }
+
+    private:
+        template <typename Call>
+        void add_streaming_receives(
+            service& service,
+            ::grpc::internal::RpcMethod::RpcType type,
+            int methodIndex,
+            const std::function<void(Call)>& cb)
+        {
+            add_receives(service, [&](::grpc::ServerCompletionQueue* cq)
+            {
+                return new streaming_call_data<Call>{ service, type, methodIndex, cq, cb };
+            });
+        }
+
+        template <typename MakeReceive>
+        void add_receives(service& service, const MakeReceive& makeReceive)
+        {
+            const auto& cqs = service.completion_queues();
+            BOOST_ASSERT(!cqs.empty());
+
+            const unsigned int receivesPerQueue = service.receives_per_method();
+            _receives.reserve(cqs.size() * receivesPerQueue);
+
+            for (unsigned int i = 0; i < receivesPerQueue; ++i)
+            {
+                for (::grpc::ServerCompletionQueue* cq : cqs)
+                {
+                    _receives.emplace_back(makeReceive(cq));
+                }
+            }
+        }
+
+        std::vector<std::unique_ptr<io_manager_tag>> _receives;
+    };
+
 } } } } // namespace bond::ext::grpc::detail
@@ -0,0 +1,780 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "io_manager_tag.h"
+#include "serialization.h"
+
+#include <bond/ext/grpc/scheduler.h>
+
+#ifdef _MSC_VER
+    #pragma warning (push)
+    #pragma warning (disable: 4100 4291 4702)
+#endif
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/impl/codegen/async_stream.h>
+#include <grpcpp/impl/codegen/channel_interface.h>
+#include <grpcpp/impl/codegen/client_context.h>
+#include <grpcpp/impl/codegen/completion_queue.h>
+#include <grpcpp/impl/codegen/rpc_method.h>
+#include <grpcpp/impl/codegen/server_context.h>
+#include <grpcpp/impl/codegen/status.h>
+
+#ifdef _MSC_VER
+    #pragma warning (pop)
+#endif
+
+#include <boost/assert.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+#include <boost/smart_ptr/intrusive_ref_counter.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace bond { namespace ext { namespace grpc { namespace detail
+{
+    /// @brief Completion queue tag that resumes an operation of its owner
+    /// by calling \p Handler on it.
+    template <typename T, void (T::*Handler)(bool)>
+    class member_tag final : public io_manager_tag
+    {
+    public:
+        explicit member_tag(T& owner) noexcept
+            : _owner(owner)
+        {}
+
+        void invoke(bool ok) override
+        {
+            (_owner.*Handler)(ok);
+        }
+
+    private:
+        T& _owner;
+    };
+
+
+    /// @brief Messages waiting to be written to a stream.
+    ///
+    /// gRPC allows only one outstanding write on a stream, so messages
+    /// written while another write is in flight wait here, at the back of
+    /// the message being written. The queue is not synchronized: its owner
+    /// serializes access to it.
+    class write_queue
+    {
+    public:
+        /// @return true if the message is the only one in the queue, in
+        /// which case the owner must start writing it.
+        bool push(::grpc::ByteBuffer buffer, std::function<void(bool)> written)
+        {
+            _entries.push_back(entry{ std::move(buffer), std::move(written) });
+            return _entries.size() == 1;
+        }
+
+        /// @brief The message being written.
+        ///
+        /// @note References to it stay valid until it is popped.
+        const ::grpc::ByteBuffer& front() const
+        {
+            BOOST_ASSERT(!_entries.empty());
+            return _entries.front().buffer;
+        }
+
+        /// @brief Removes the message which has been written.
+        ///
+        /// @return the callback of the message.
+        std::function<void(bool)> pop()
+        {
+            BOOST_ASSERT(!_entries.empty());
+            std::function<void(bool)> written = std::move(_entries.front().written);
+            _entries.pop_front();
+            return written;
+        }
+
+        /// @brief Removes all the messages, which will never be written.
+        ///
+        /// @return the callbacks of the messages.
+        std::vector<std::function<void(bool)>> clear()
+        {
+            std::vector<std::function<void(bool)>> callbacks;
+            callbacks.reserve(_entries.size());
+
+            for (entry& e : _entries)
+            {
+                callbacks.push_back(std::move(e.written));
+            }
+
+            _entries.clear();
+            return callbacks;
+        }
+
+        bool empty() const noexcept
+        {
+            return _entries.empty();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return _entries.size();
+        }
+
+    private:
+        struct entry
+        {
+            /*::grpc::*/ByteBuffer buffer;
+            std::function<void(bool)> written;
+        };
+
+        std::deque<entry> _entries;
+    };
+
+
+    /// @brief Base class for the state of a streaming call, be it on the
+    /// server or on the client.
+    ///
+    /// Every outstanding operation holds a reference to the call, so that it
+    /// stays alive until the operation completes. The user-facing objects
+    /// hold both a reference and a user reference: when the last user
+    /// reference goes away, %on_last_user_ref() closes the writing side of
+    /// the stream.
+    template <typename Derived>
+    class stream_impl_base : public boost::intrusive_ref_counter<Derived>
+    {
+    public:
+        void AddUserRef() noexcept
+        {
+            _userRefs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        void ReleaseUserRef()
+        {
+            if (_userRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                static_cast<Derived&>(*this).on_last_user_ref();
+            }
+        }
+
+        std::size_t pending_writes() const
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+            return _writes.size();
+        }
+
+    protected:
+        explicit stream_impl_base(const Scheduler& scheduler)
+            : _scheduler{ scheduler }
+        {
+            BOOST_ASSERT(_scheduler);
+        }
+
+        /// @brief Takes over the reference that was added to the call when
+        /// an operation was started.
+        boost::intrusive_ptr<Derived> adopt_op_ref() noexcept
+        {
+            return boost::intrusive_ptr<Derived>{ static_cast<Derived*>(this), false };
+        }
+
+        /// @brief Adds the reference that an operation being started holds.
+        void add_op_ref() noexcept
+        {
+            intrusive_ptr_add_ref(static_cast<Derived*>(this));
+        }
+
+        void complete(std::function<void(bool)> written, bool ok)
+        {
+            if (written)
+            {
+                _scheduler(std::bind(std::move(written), ok));
+            }
+        }
+
+        void complete(std::vector<std::function<void(bool)>> written, bool ok)
+        {
+            for (auto& w : written)
+            {
+                complete(std::move(w), ok);
+            }
+        }
+
+        Scheduler _scheduler;
+        mutable std::mutex _mutex;
+        write_queue _writes;
+
+    private:
+        std::atomic<std::size_t> _userRefs{ 0 };
+    };
+
+
+    /// @brief Implementation class that holds the state associated with a
+    /// single streaming call received by a service.
+    ///
+    /// The same class serves server-streaming, client-streaming and
+    /// bidirectional calls: they differ only in which of its operations the
+    /// user-facing classes expose. Finishing the call is deferred until all
+    /// the messages written before have been sent.
+    class server_stream_impl final : public stream_impl_base<server_stream_impl>
+    {
+    public:
+        using stream_type = ::grpc::ServerAsyncReaderWriter<::grpc::ByteBuffer, ::grpc::ByteBuffer>;
+
+        explicit server_stream_impl(const Scheduler& scheduler)
+            : stream_impl_base{ scheduler }
+        {}
+
+        const ::grpc::ServerContext& context() const noexcept
+        {
+            return _context;
+        }
+
+        ::grpc::ServerContext& context() noexcept
+        {
+            return _context;
+        }
+
+        ::grpc::ByteBuffer& request_buffer() noexcept
+        {
+            return _requestBuffer;
+        }
+
+        stream_type& stream() noexcept
+        {
+            return _stream;
+        }
+
+        /// @brief Reads the next message from the client.
+        ///
+        /// The next message is not read from the transport until \p callback
+        /// has returned, so a slow reader makes gRPC flow control slow down
+        /// the client. At most one read can be outstanding.
+        ///
+        /// @param callback invoked with false once the client is done
+        /// writing or the call is over.
+        void Read(std::function<void(bool, const ::grpc::ByteBuffer&)> callback)
+        {
+            BOOST_ASSERT(callback);
+
+            std::unique_lock<std::mutex> lock{ _mutex };
+            BOOST_ASSERT(!_readCallback);
+
+            if (_finished)
+            {
+                lock.unlock();
+                _scheduler(std::bind(std::move(callback), false, ByteBuffer{}));
+                return;
+            }
+
+            _readCallback = std::move(callback);
+            add_op_ref();
+            _stream.Read(&_readBuffer, _readTag.tag());
+        }
+
+        /// @brief Queues a message to be written to the client.
+        ///
+        /// @param written invoked with whether the message was written, once
+        /// it has been handed to the transport.
+        void Write(::grpc::ByteBuffer buffer, std::function<void(bool)> written)
+        {
+            std::unique_lock<std::mutex> lock{ _mutex };
+
+            if (_finishRequested)
+            {
+                lock.unlock();
+                complete(std::move(written), false);
+                return;
+            }
+
+            if (_writes.push(std::move(buffer), std::move(written)))
+            {
+                start_write();
+            }
+        }
+
+        /// @brief Finishes the call with \p status once the queued messages
+        /// have been written.
+        ///
+        /// Only the first call to \p Finish will be honored.
+        void Finish(const ::grpc::Status& status)
+        {
+            Finish(status, nullptr);
+        }
+
+        /// @brief Sends \p response and finishes the call successfully once
+        /// the queued messages have been written.
+        ///
+        /// Only the first call to \p Finish will be honored.
+        void Finish(const ::grpc::ByteBuffer& response)
+        {
+            Finish(::grpc::Status::OK, &response);
+        }
+
+    private:
+        friend class stream_impl_base<server_stream_impl>;
+
+        void Finish(const ::grpc::Status& status, const ::grpc::ByteBuffer* response)
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+
+            if (_finishRequested)
+            {
+                return;
+            }
+
+            _finishRequested = true;
+            _status = status;
+
+            if (response)
+            {
+                _response.reset(new ::grpc::ByteBuffer{ *response });
+            }
+
+            if (_writes.empty())
+            {
+                start_finish();
+            }
+        }
+
+        void on_last_user_ref()
+        {
+            // Like for unary calls, the call is failed if the user stopped
+            // referencing it without finishing it.
+            Finish(::grpc::Status{ ::grpc::StatusCode::INTERNAL, "An internal server error has occurred." });
+        }
+
+        // Must be called with _mutex held.
+        void start_write()
+        {
+            add_op_ref();
+            _stream.Write(_writes.front(), _writeTag.tag());
+        }
+
+        // Must be called with _mutex held.
+        void start_finish()
+        {
+            add_op_ref();
+
+            if (_response)
+            {
+                _stream.WriteAndFinish(*_response, ::grpc::WriteOptions{}, _status, _finishTag.tag());
+            }
+            else
+            {
+                _stream.Finish(_status, _finishTag.tag());
+            }
+        }
+
+        void on_read(bool ok)
+        {
+            auto self = adopt_op_ref();
+            std::function<void(bool, const ::grpc::ByteBuffer&)> callback;
+
+            {
+                std::lock_guard<std::mutex> lock{ _mutex };
+                callback = std::move(_readCallback);
+                _readCallback = nullptr;
+            }
+
+            BOOST_ASSERT(callback);
+
+            // TODO: Use lambda with move-capture when allowed to use C++14.
+            _scheduler(std::bind(std::move(callback), ok, ByteBuffer{ _readBuffer }));
+        }
+
+        void on_write(bool ok)
+        {
+            auto self = adopt_op_ref();
+            std::function<void(bool)> written;
+            std::vector<std::function<void(bool)>> dropped;
+
+            {
+                std::lock_guard<std::mutex> lock{ _mutex };
+                written = _writes.pop();
+
+                if (!ok)
+                {
+                    // The stream is broken: none of the queued messages will
+                    // make it to the client.
+                    dropped = _writes.clear();
+                }
+
+                if (!_writes.empty())
+                {
+                    start_write();
+                }
+                else if (_finishRequested)
+                {
+                    start_finish();
+                }
+            }
+
+            complete(std::move(written), ok);
+            complete(std::move(dropped), false);
+        }
+
+        void on_finish(bool /* ok */)
+        {
+            auto self = adopt_op_ref();
+
+            std::lock_guard<std::mutex> lock{ _mutex };
+            _finished = true;
+        }
+
+        // A pointer to the context is passed to _stream when constructing
+        // it, so this needs to be declared before _stream.
+        ::grpc::ServerContext _context{};
+        stream_type _stream{ &_context };
+        ::grpc::ByteBuffer _requestBuffer;
+        ::grpc::ByteBuffer _readBuffer;
+        std::function<void(bool, const ::grpc::ByteBuffer&)> _readCallback;
+        ::grpc::Status _status;
+        std::unique_ptr<::grpc::ByteBuffer> _response;
+        bool _finishRequested = false;
+        bool _finished = false;
+        member_tag<server_stream_impl, &server_stream_impl::on_read> _readTag{ *this };
+        member_tag<server_stream_impl, &server_stream_impl::on_write> _writeTag{ *this };
+        member_tag<server_stream_impl, &server_stream_impl::on_finish> _finishTag{ *this };
+    };
+
+
+    /// @brief Implementation class that holds the state associated with a
+    /// single outgoing streaming call.
+    ///
+    /// Messages from the service are read one at a time: the next one is
+    /// only read once the callback for the previous one has returned, which
+    /// lets gRPC flow control push back on the service when the client
+    /// can't keep up. Once the service is done writing, the status of the
+    /// call is received and passed to the finish callback.
+    class client_stream_impl final : public stream_impl_base<client_stream_impl>
+    {
+    public:
+        using message_callback = std::function<void(const ::grpc::ByteBuffer&)>;
+
+        using finish_callback = std::function<void(
+            const ::grpc::ByteBuffer& lastMessage,
+            const ::grpc::Status& status,
+            std::shared_ptr<::grpc::ClientContext> context)>;
+
+        /// @param onMessage invoked for each message read from the service.
+        /// When empty, the messages are not delivered and the last one is
+        /// passed to \p onFinish instead, as client-streaming calls need.
+        client_stream_impl(
+            std::shared_ptr<::grpc::CompletionQueue> cq,
+            std::shared_ptr<::grpc::ChannelInterface> channel,
+            std::shared_ptr<::grpc::ClientContext> context,
+            const Scheduler& scheduler,
+            message_callback onMessage,
+            finish_callback onFinish)
+            : stream_impl_base{ scheduler },
+              _cq{ std::move(cq) },
+              _channel{ std::move(channel) },
+              _context{ std::move(context) },
+              _onMessage{ std::move(onMessage) },
+              _onFinish{ std::move(onFinish) }
+        {
+            BOOST_ASSERT(_context);
+        }
+
+        const std::shared_ptr<::grpc::ClientContext>& context() const noexcept
+        {
+            return _context;
+        }
+
+        /// @brief Starts the call.
+        ///
+        /// @note The caller must hold a reference to this instance.
+        void Start(const ::grpc::internal::RpcMethod& method)
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+
+            add_op_ref();
+            _stream.reset(
+                ::grpc::internal::ClientAsyncReaderWriterFactory<::grpc::ByteBuffer, ::grpc::ByteBuffer>::Create(
+                    _channel.get(),
+                    _cq.get(),
+                    method,
+                    _context.get(),
+                    /* start */ true,
+                    _startTag.tag()));
+
+            start_read();
+        }
+
+        /// @brief Queues a message to be written to the service.
+        ///
+        /// @param written invoked with whether the message was written, once
+        /// it has been handed to the transport.
+        void Write(::grpc::ByteBuffer buffer, std::function<void(bool)> written)
+        {
+            std::unique_lock<std::mutex> lock{ _mutex };
+
+            if (_writesDoneRequested || _broken)
+            {
+                lock.unlock();
+                complete(std::move(written), false);
+                return;
+            }
+
+            if (_writes.push(std::move(buffer), std::move(written)) && _started)
+            {
+                start_write();
+            }
+        }
+
+        /// @brief Tells the service that no more messages will be written,
+        /// once the queued ones have been.
+        void WritesDone()
+        {
+            std::lock_guard<std::mutex> lock{ _mutex };
+
+            if (_writesDoneRequested)
+            {
+                return;
+            }
+
+            _writesDoneRequested = true;
+
+            if (_started && _writes.empty() && !_broken)
+            {
+                start_writes_done();
+            }
+        }
+
+    private:
+        friend class stream_impl_base<client_stream_impl>;
+
+        void on_last_user_ref()
+        {
+            WritesDone();
+        }
+
+        // Must be called with _mutex held.
+        void start_write()
+        {
+            add_op_ref();
+            _stream->Write(_writes.front(), _writeTag.tag());
+        }
+
+        // Must be called with _mutex held.
+        void start_writes_done()
+        {
+            add_op_ref();
+            _stream->WritesDone(_writesDoneTag.tag());
+        }
+
+        void start_read()
+        {
+            add_op_ref();
+            _stream->Read(&_readBuffer, _readTag.tag());
+        }
+
+        void on_start(bool ok)
+        {
+            auto self = adopt_op_ref();
+            std::vector<std::function<void(bool)>> dropped;
+
+            {
+                std::lock_guard<std::mutex> lock{ _mutex };
+
+                // The start operation uses the same gRPC op set as writes,
+                // so no write can be started before it has completed.
+                _started = true;
+
+                if (!ok)
+                {
+                    _broken = true;
+                    dropped = _writes.clear();
+                }
+                else if (!_writes.empty())
+                {
+                    start_write();
+                }
+                else if (_writesDoneRequested)
+                {
+                    start_writes_done();
+                }
+            }
+
+            complete(std::move(dropped), false);
+        }
+
+        void on_write(bool ok)
+        {
+            auto self = adopt_op_ref();
+            std::function<void(bool)> written;
+            std::vector<std::function<void(bool)>> dropped;
+
+            {
+                std::lock_guard<std::mutex> lock{ _mutex };
+                written = _writes.pop();
+
+                if (!ok)
+                {
+                    _broken = true;
+                    dropped = _writes.clear();
+                }
+                else if (!_writes.empty())
+                {
+                    start_write();
+                }
+                else if (_writesDoneRequested)
+                {
+                    start_writes_done();
+                }
+            }
+
+            complete(std::move(written), ok);
+            complete(std::move(dropped), false);
+        }
+
+        void on_writes_done(bool /* ok */)
+        {
+            auto self = adopt_op_ref();
+        }
+
+        void on_read(bool ok)
+        {
+            auto self = adopt_op_ref();
+
+            if (!ok)
+            {
+                // The service is done writing: get the status of the call.
+                add_op_ref();
+                _stream->Finish(&_status, _finishTag.tag());
+            }
+            else if (_onMessage)
+            {
+                // TODO: Use lambda with move-capture when allowed to use C++14.
+                _scheduler(std::bind(&client_stream_impl::deliver, std::move(self), ByteBuffer{ _readBuffer }));
+            }
+            else
+            {
+                _lastMessage = _readBuffer;
+                start_read();
+            }
+        }
+
+        void deliver(const ::grpc::ByteBuffer& buffer)
+        {
+            _onMessage(buffer);
+            start_read();
+        }
+
+        void on_finish(bool /* ok */)
+        {
+            auto self = adopt_op_ref();
+
+            // The callbacks often hold user references to this call, so they
+            // are released now that the call is over to break the cycle.
+            _onMessage = nullptr;
+
+            if (_onFinish)
+            {
+                _scheduler(std::bind(std::move(_onFinish), ByteBuffer{ _lastMessage }, _status, _context));
+                _onFinish = nullptr;
+            }
+        }
+
+        /// The completion port to post IO operations to.
+        std::shared_ptr<::grpc::CompletionQueue> _cq;
+        /// The channel to send the messages on.
+        std::shared_ptr<::grpc::ChannelInterface> _channel;
+        /// The client context under which the call is executed.
+        std::shared_ptr<::grpc::ClientContext> _context;
+        /// The stream, allocated in the arena of the call.
+        std::unique_ptr<::grpc::ClientAsyncReaderWriter<::grpc::ByteBuffer, ::grpc::ByteBuffer>> _stream;
+        message_callback _onMessage;
+        finish_callback _onFinish;
+        ::grpc::ByteBuffer _readBuffer;
+        ::grpc::ByteBuffer _lastMessage;
+        ::grpc::Status _status;
+        bool _started = false;
+        bool _broken = false;
+        bool _writesDoneRequested = false;
+        member_tag<client_stream_impl, &client_stream_impl::on_start> _startTag{ *this };
+        member_tag<client_stream_impl, &client_stream_impl::on_read> _readTag{ *this };
+        member_tag<client_stream_impl, &client_stream_impl::on_write> _writeTag{ *this };
+        member_tag<client_stream_impl, &client_stream_impl::on_writes_done> _writesDoneTag{ *this };
+        member_tag<client_stream_impl, &client_stream_impl::on_finish> _finishTag{ *this };
+    };
+
+
+    /// @brief A user reference to a streaming call.
+    ///
+    /// Copies share the call. When the last one goes away, the call is
+    /// told so through stream_impl_base::ReleaseUserRef.
+    template <typename Impl>
+    class stream_ref
+    {
+    public:
+        stream_ref() = default;
+
+        explicit stream_ref(boost::intrusive_ptr<Impl> impl) noexcept
+            : _impl{ std::move(impl) }
+        {
+            if (_impl)
+            {
+                _impl->AddUserRef();
+            }
+        }
+
+        stream_ref(const stream_ref& other) noexcept
+            : _impl{ other._impl }
+        {
+            if (_impl)
+            {
+                _impl->AddUserRef();
+            }
+        }
+
+        stream_ref(stream_ref&& other) = default;
+
+        stream_ref& operator=(stream_ref other) noexcept
+        {
+            swap(other);
+            return *this;
+        }
+
+        ~stream_ref()
+        {
+            if (_impl)
+            {
+                _impl->ReleaseUserRef();
+            }
+        }
+
+        void swap(stream_ref& other) noexcept
+        {
+            using std::swap;
+            swap(_impl, other._impl);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return static_cast<bool>(_impl);
+        }
+
+        Impl& operator*() const noexcept
+        {
+            BOOST_ASSERT(_impl);
+            return *_impl;
+        }
+
+        Impl* operator->() const noexcept
+        {
+            BOOST_ASSERT(_impl);
+            return _impl.get();
+        }
+
+    private:
+        boost::intrusive_ptr<Impl> _impl;
+    };
+
+} } } } // namespace bond::ext::grpc::detail
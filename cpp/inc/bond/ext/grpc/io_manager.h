@@ -5,6 +5,7 @@
 
 #include <bond/core/config.h>
 
+#include "detail/cpu_affinity.h"
 #include "detail/io_manager_tag.h"
 #include "exception.h"
 #include <bond/core/detail/once.h>
@@ -25,6 +26,7 @@
 #include <boost/thread/scoped_thread.hpp>
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -61,10 +63,19 @@ namespace bond { namespace ext { namespace grpc
         ///
         /// @param cq the completion queue to poll.
         ///
+        /// @param cpus the CPUs to pin the threads to. The i-th thread is
+        /// pinned to <tt>cpus[i % cpus.size()]</tt>. If empty, the threads
+        /// are not pinned.
+        ///
         /// @throws InvalidThreadCount when std::thread::hardware_concurrency returns 0.
-        explicit io_manager(unsigned int numThreads, bool delay = false, std::unique_ptr<::grpc::CompletionQueue> cq = {})
+        explicit io_manager(
+            unsigned int numThreads,
+            bool delay = false,
+            std::unique_ptr<::grpc::CompletionQueue> cq = {},
+            std::vector<unsigned int> cpus = {})
             : _cq{ cq ? std::move(cq) : std::unique_ptr<::grpc::CompletionQueue>{ new ::grpc::CompletionQueue{} } },
-              _threads{ numThreads }
+              _threads{ numThreads },
+              _cpus{ std::move(cpus) }
         {
             if (_threads.empty())
             {
@@ -105,11 +116,13 @@ namespace bond { namespace ext { namespace grpc
             BOOST_ASSERT(_cq);
             BOOST_ASSERT(!_threads.empty());
 
-            for (auto& t : _threads)
+            for (std::size_t i = 0; i < _threads.size(); ++i)
             {
+                auto& t = _threads[i];
+
                 if (!t.joinable())
                 {
-                    t = boost::scoped_thread<>{ [this]{ run(); } };
+                    t = boost::scoped_thread<>{ [this, i]{ run(i); } };
                 }
             }
         }
@@ -154,8 +167,13 @@ namespace bond { namespace ext { namespace grpc
             return _cq;
         }
 
-        void run()
+        void run(std::size_t index)
         {
+            if (!_cpus.empty())
+            {
+                detail::pin_current_thread(_cpus[index % _cpus.size()]);
+            }
+
             void* tag;
             bool ok;
             while (_cq->Next(&tag, &ok))
@@ -167,6 +185,7 @@ namespace bond { namespace ext { namespace grpc
 
         std::shared_ptr<::grpc::CompletionQueue> _cq;
         std::vector<boost::scoped_thread<>> _threads;
+        std::vector<unsigned int> _cpus;
 
         std::atomic_flag _isShutdownRequested = ATOMIC_FLAG_INIT;
         bond::detail::once_flag _waitFlag{};
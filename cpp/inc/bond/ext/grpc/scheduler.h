@@ -5,7 +5,15 @@
 
 #include <bond/core/config.h>
 
+#include "task.h"
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 namespace bond { namespace ext { namespace grpc
 {
@@ -22,12 +30,134 @@ class scheduler
     /// resources may not be freed.
     ///
     /// @param callback functor object to be scheduled. Must accept any
-    /// callable object.
+    /// callable object. Schedulers for which \ref is_task_scheduler is true
+    /// must also accept move-only ones, such as a \ref task.
     template <typename Callback>
     void operator()(Callback&& callback);
 };
 #endif
 
-using Scheduler = std::function<void(const std::function<void()>& func)>;
+/// @brief Whether a scheduler accepts move-only callbacks, in which case
+/// \ref Scheduler hands it a \ref task, which doesn't allocate for the
+/// callbacks scheduled for each call.
+///
+/// Other schedulers are handed a std::function, which allocates. Specialize
+/// this trait for schedulers which take any callable object without copying
+/// it.
+template <typename T>
+struct is_task_scheduler
+    : std::false_type {};
+
+/// @brief Type-erased scheduler used by Bond-over-gRPC services and clients.
+///
+/// Can be created from any object implementing the scheduler interface, and
+/// from a std::function<void(const std::function<void()>&)>. Copies share
+/// the wrapped scheduler.
+class Scheduler
+{
+public:
+    /// @brief Creates an empty Scheduler.
+    Scheduler() = default;
+
+    /// @brief Creates an empty Scheduler.
+    Scheduler(std::nullptr_t) noexcept
+    {}
+
+    /// @brief Creates a Scheduler which schedules callbacks with a copy of
+    /// \p scheduler. The Scheduler is empty if \p scheduler is an empty
+    /// std::function.
+    template <
+        typename T,
+        typename S = typename std::decay<T>::type,
+        typename std::enable_if<
+            !std::is_same<S, Scheduler>::value
+            && !std::is_same<S, std::nullptr_t>::value>::type* = nullptr>
+    Scheduler(T&& scheduler)
+        : _impl{ is_empty(scheduler)
+            ? nullptr
+            : std::make_shared<impl<S>>(std::forward<T>(scheduler)) }
+    {}
+
+    /// @brief Schedules a callback for execution.
+    void operator()(task callback) const
+    {
+        BOOST_ASSERT(_impl);
+        BOOST_ASSERT(callback);
+        _impl->schedule(std::move(callback));
+    }
+
+    /// @brief Returns true if this Scheduler is non-empty; otherwise false.
+    explicit operator bool() const noexcept
+    {
+        return static_cast<bool>(_impl);
+    }
+
+private:
+    struct impl_base
+    {
+        virtual ~impl_base() = default;
+
+        virtual void schedule(task&& callback) = 0;
+    };
+
+    template <typename S, bool = is_task_scheduler<S>::value>
+    struct impl final : impl_base
+    {
+        template <typename T>
+        explicit impl(T&& scheduler)
+            : _scheduler(std::forward<T>(scheduler))
+        {}
+
+        void schedule(task&& callback) override
+        {
+            _scheduler(std::move(callback));
+        }
+
+        S _scheduler;
+    };
+
+    /// Makes a task copyable, so that it can be scheduled by schedulers
+    /// taking std::function.
+    struct shared_task
+    {
+        void operator()() const
+        {
+            (*callback)();
+        }
+
+        std::shared_ptr<task> callback;
+    };
+
+    template <typename S>
+    struct impl<S, false> final : impl_base
+    {
+        template <typename T>
+        explicit impl(T&& scheduler)
+            : _scheduler(std::forward<T>(scheduler))
+        {}
+
+        void schedule(task&& callback) override
+        {
+            _scheduler(std::function<void()>{
+                shared_task{ std::make_shared<task>(std::move(callback)) } });
+        }
+
+        S _scheduler;
+    };
+
+    template <typename Signature>
+    static bool is_empty(const std::function<Signature>& scheduler) noexcept
+    {
+        return !scheduler;
+    }
+
+    template <typename S>
+    static bool is_empty(const S& /*scheduler*/) noexcept
+    {
+        return false;
+    }
+
+    std::shared_ptr<impl_base> _impl;
+};
 
 } } } // namespace bond::ext::grpc
@@ -58,6 +58,7 @@
 #include <boost/assert.hpp>
 #include <boost/range/combine.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <thread>
@@ -65,6 +66,35 @@
 
 namespace bond { namespace ext { namespace grpc
 {
+    /// @brief Configures the completion queues of a server and the threads
+    /// polling them.
+    ///
+    /// The default configuration is a single completion queue polled by one
+    /// thread per CPU/core. With more than one completion queue, every method
+    /// of every service keeps a pending receive on each queue, so incoming
+    /// calls are spread over the queues and each call is then processed by
+    /// the threads of the queue it was received on.
+    struct server_options
+    {
+        /// @brief Number of completion queues. If 0, one completion queue is
+        /// created per CPU/core.
+        unsigned int completion_queues = 1;
+
+        /// @brief Number of threads polling each completion queue. If 0, the
+        /// CPUs/cores are divided evenly among the completion queues, with
+        /// at least one thread per queue.
+        unsigned int threads_per_queue = 0;
+
+        /// @brief Whether to pin the polling threads to CPUs.
+        ///
+        /// The threads of the i-th completion queue are pinned to
+        /// consecutive CPUs starting at <tt>i * threads_per_queue</tt>
+        /// (modulo the number of CPUs), so that e.g. with one queue per NUMA
+        /// node and consecutively numbered CPUs in each node, the threads of a
+        /// queue stay on one node.
+        bool pin_threads = false;
+    };
+
     /// @brief Models a grpc server powered by Bond services.
     ///
     /// Servers are configured and started via bond::ext:grpc::server::Start.
@@ -85,7 +115,40 @@ namespace bond { namespace ext { namespace grpc
         /// for the provided services.
         static server Start(::grpc::ServerBuilder& builder, service_collection services)
         {
-            auto cq = builder.AddCompletionQueue();
+            return Start(builder, std::move(services), server_options{});
+        }
+
+        /// @brief Builds and returns a running server which is ready to process calls
+        /// for the provided services, with the completion queues and polling
+        /// threads described by \p options.
+        ///
+        /// @throws InvalidThreadCount when the number of CPUs/cores is needed
+        /// and std::thread::hardware_concurrency returns 0.
+        static server Start(
+            ::grpc::ServerBuilder& builder,
+            service_collection services,
+            const server_options& options)
+        {
+            const unsigned int numCpus = std::thread::hardware_concurrency();
+            const unsigned int numQueues = options.completion_queues != 0 ? options.completion_queues : numCpus;
+
+            if (numQueues == 0)
+            {
+                throw InvalidThreadCount{};
+            }
+
+            const unsigned int threadsPerQueue = options.threads_per_queue != 0
+                ? options.threads_per_queue
+                : (std::max)(numCpus / numQueues, 1u);
+
+            std::vector<std::unique_ptr<::grpc::ServerCompletionQueue>> cqs;
+            std::vector<::grpc::ServerCompletionQueue*> serviceCqs;
+
+            for (unsigned int i = 0; i < numQueues; ++i)
+            {
+                cqs.push_back(builder.AddCompletionQueue());
+                serviceCqs.push_back(cqs.back().get());
+            }
 
             for (const auto& item : boost::combine(services.services(), services.names()))
             {
@@ -100,16 +163,33 @@ namespace bond { namespace ext { namespace grpc
                     builder.RegisterService(service->grpc_service());
                 }
 
-                service->SetCompletionQueue(cq.get());
+                service->SetCompletionQueues(serviceCqs);
             }
 
             if (auto svr = builder.BuildAndStart())
             {
+                std::vector<std::unique_ptr<io_manager>> ioManagers;
+
+                for (unsigned int i = 0; i < numQueues; ++i)
+                {
+                    std::vector<unsigned int> cpus;
+
+                    if (options.pin_threads && numCpus != 0)
+                    {
+                        for (unsigned int t = 0; t < threadsPerQueue; ++t)
+                        {
+                            cpus.push_back((i * threadsPerQueue + t) % numCpus);
+                        }
+                    }
+
+                    ioManagers.emplace_back(new io_manager{
+                        threadsPerQueue, /*delay=*/ false, std::move(cqs[i]), std::move(cpus) });
+                }
+
                 return server{
                     std::move(svr),
                     std::move(services.services()),
-                    std::unique_ptr<io_manager>{ new io_manager{
-                        std::thread::hardware_concurrency(), /*delay=*/ false, std::move(cq) } } };
+                    std::move(ioManagers) };
             }
 
             throw ServerBuildException{};
@@ -161,13 +241,13 @@ namespace bond { namespace ext { namespace grpc
         server(
             std::unique_ptr<::grpc::Server> server,
             std::vector<std::unique_ptr<detail::service>> services,
-            std::unique_ptr<io_manager> ioManager)
+            std::vector<std::unique_ptr<io_manager>> ioManagers)
             : _server{ std::move(server) },
               _services{ std::move(services) },
-              _ioManager{ std::move(ioManager) }
+              _ioManagers{ std::move(ioManagers) }
         {
             BOOST_ASSERT(_server);
-            BOOST_ASSERT(_ioManager);
+            BOOST_ASSERT(!_ioManagers.empty());
 
             start();
         }
@@ -182,7 +262,7 @@ namespace bond { namespace ext { namespace grpc
 
         std::unique_ptr<::grpc::Server> _server;
         std::vector<std::unique_ptr<detail::service>> _services;
-        std::unique_ptr<io_manager> _ioManager;
+        std::vector<std::unique_ptr<io_manager>> _ioManagers;
     };
 
 } } } //namespace bond::ext::grpc
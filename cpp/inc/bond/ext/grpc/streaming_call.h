@@ -0,0 +1,326 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "detail/lazy_bonded.h"
+#include "detail/serialization.h"
+#include "detail/streaming_call_impl.h"
+
+#include <bond/core/bonded.h>
+
+#include <boost/optional/optional.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace bond { namespace ext { namespace grpc
+{
+namespace detail
+{
+    /// @brief Detail class that helps implement \ref server_streaming_call,
+    /// \ref client_streaming_call and \ref bidi_streaming_call.
+    ///
+    /// The operations are protected and made public by the classes for the
+    /// kinds of calls which allow them.
+    template <typename Request, typename Response>
+    class streaming_call_base
+    {
+    public:
+        /// @brief Returns true if this call is non-empty; otherwise false.
+        explicit operator bool() const noexcept
+        {
+            return static_cast<bool>(_impl);
+        }
+
+        /// @brief Get the server context for this call.
+        const ::grpc::ServerContext& context() const noexcept
+        {
+            return _impl->context();
+        }
+
+        /// @brief Get the server context for this call.
+        ::grpc::ServerContext& context() noexcept
+        {
+            return _impl->context();
+        }
+
+    protected:
+        streaming_call_base() = default;
+
+        explicit streaming_call_base(boost::intrusive_ptr<server_stream_impl> impl) noexcept
+            : _impl{ std::move(impl) }
+        {}
+
+        /// @brief Reads the next message from the client.
+        ///
+        /// The next message is only read from the transport after Read is
+        /// called again, so a service which can't keep up slows the client
+        /// down through gRPC flow control. At most one read can be
+        /// outstanding.
+        ///
+        /// @param callback invoked with the message, or with an empty
+        /// optional once the client is done writing.
+        void Read(const std::function<void(boost::optional<bonded<Request>>)>& callback)
+        {
+            BOOST_ASSERT(callback);
+
+            // TODO: Use lambda with move-capture when allowed to use C++14.
+            _impl->Read(std::bind(
+                [](const std::function<void(boost::optional<bonded<Request>>)>& cb,
+                    bool ok,
+                    const ::grpc::ByteBuffer& buffer)
+                {
+                    if (ok)
+                    {
+                        cb(Deserialize<Request>(buffer));
+                    }
+                    else
+                    {
+                        cb(boost::none);
+                    }
+                },
+                callback,
+                std::placeholders::_1,
+                std::placeholders::_2));
+        }
+
+        /// @brief Writes a message to the client.
+        ///
+        /// Messages written while a previous one is still being sent are
+        /// queued; \ref pending_writes tells how many are.
+        ///
+        /// @param written optional callback invoked with whether the message
+        /// has been handed to the transport. Waiting for it before writing
+        /// more applies gRPC flow control to the service.
+        void Write(const Response& msg, const std::function<void(bool)>& written = {})
+        {
+            Write(bonded<Response>{ boost::ref(msg) }, written);
+        }
+
+        /// @brief Writes a message to the client.
+        void Write(const bonded<Response>& msg, const std::function<void(bool)>& written = {})
+        {
+            _impl->Write(Serialize(msg), written);
+        }
+
+        /// @brief The number of written messages which have not been handed
+        /// to the transport yet, including the one being sent.
+        std::size_t pending_writes() const
+        {
+            return _impl->pending_writes();
+        }
+
+        server_stream_impl& impl() const noexcept
+        {
+            return *_impl;
+        }
+
+    private:
+        stream_ref<server_stream_impl> _impl;
+    };
+
+} // namespace detail
+
+    /// @brief A call to a method that sends a stream of messages to the
+    /// client in response to a single request.
+    ///
+    /// Copies of a call share it. Call \ref Finish once all the messages
+    /// have been written: the status is sent after them. If \p Finish has
+    /// not been called when the last copy is destroyed, a generic internal
+    /// server error is sent.
+    template <typename Request, typename Response>
+    class server_streaming_call final
+        : public detail::streaming_call_base<
+            typename std::conditional<std::is_void<Request>::value, Void, Request>::type,
+            Response>
+    {
+    public:
+        /// @brief The type of the request: \ref Void for methods without input.
+        using request_type = typename std::conditional<std::is_void<Request>::value, Void, Request>::type;
+
+        /// @brief Creates an empty server_streaming_call.
+        server_streaming_call() = default;
+
+        explicit server_streaming_call(boost::intrusive_ptr<detail::server_stream_impl> impl)
+            : server_streaming_call::streaming_call_base(std::move(impl)),
+              _request{ this->impl().request_buffer() }
+        {}
+
+        /// @brief Get the request message for this call.
+        const bonded<request_type>& request() const
+        {
+            return _request.get();
+        }
+
+        using server_streaming_call::streaming_call_base::Write;
+        using server_streaming_call::streaming_call_base::pending_writes;
+
+        /// @brief Finishes the call with the given status, once the messages
+        /// written before have been sent.
+        ///
+        /// Only the first call to \p Finish will be honored.
+        void Finish(const ::grpc::Status& status = ::grpc::Status::OK)
+        {
+            this->impl().Finish(status);
+        }
+
+    private:
+        detail::lazy_bonded<request_type> _request;
+    };
+
+    /// @brief A call to a method that receives a stream of messages from
+    /// the client and responds with a single message.
+    ///
+    /// Copies of a call share it. If \ref Finish has not been called when
+    /// the last copy is destroyed, a generic internal server error is sent.
+    template <typename Request, typename Response>
+    class client_streaming_call final
+        : public detail::streaming_call_base<
+            Request,
+            typename std::conditional<std::is_void<Response>::value, Void, Response>::type>
+    {
+    public:
+        /// @brief The type of the response: \ref Void for methods without result.
+        using response_type = typename std::conditional<std::is_void<Response>::value, Void, Response>::type;
+
+        /// @brief Creates an empty client_streaming_call.
+        client_streaming_call() = default;
+
+        explicit client_streaming_call(boost::intrusive_ptr<detail::server_stream_impl> impl) noexcept
+            : client_streaming_call::streaming_call_base(std::move(impl))
+        {}
+
+        using client_streaming_call::streaming_call_base::Read;
+
+        /// @brief Responds to the client with the given message.
+        ///
+        /// Only the first call to \p Finish will be honored.
+        void Finish(const response_type& msg = {})
+        {
+            Finish(bonded<response_type>{ boost::ref(msg) });
+        }
+
+        /// @brief Responds to the client with the given message.
+        ///
+        /// Only the first call to \p Finish will be honored.
+        void Finish(const bonded<response_type>& msg)
+        {
+            this->impl().Finish(detail::Serialize(msg));
+        }
+
+        /// @brief Responds to the client with the given status and no message.
+        ///
+        /// Only the first call to \p Finish will be honored.
+        void Finish(const ::grpc::Status& status)
+        {
+            this->impl().Finish(status);
+        }
+    };
+
+    /// @brief A call to a method that both receives and sends a stream of
+    /// messages.
+    ///
+    /// Reading and writing are independent: messages can be written while a
+    /// read is outstanding. Copies of a call share it. Call \ref Finish once
+    /// all the messages have been written: the status is sent after them.
+    /// If \p Finish has not been called when the last copy is destroyed, a
+    /// generic internal server error is sent.
+    template <typename Request, typename Response>
+    class bidi_streaming_call final : public detail::streaming_call_base<Request, Response>
+    {
+    public:
+        /// @brief Creates an empty bidi_streaming_call.
+        bidi_streaming_call() = default;
+
+        explicit bidi_streaming_call(boost::intrusive_ptr<detail::server_stream_impl> impl) noexcept
+            : bidi_streaming_call::streaming_call_base(std::move(impl))
+        {}
+
+        using bidi_streaming_call::streaming_call_base::Read;
+        using bidi_streaming_call::streaming_call_base::Write;
+        using bidi_streaming_call::streaming_call_base::pending_writes;
+
+        /// @brief Finishes the call with the given status, once the messages
+        /// written before have been sent.
+        ///
+        /// Only the first call to \p Finish will be honored.
+        void Finish(const ::grpc::Status& status = ::grpc::Status::OK)
+        {
+            this->impl().Finish(status);
+        }
+    };
+
+
+    /// @brief The client side of a call which streams messages to a
+    /// service.
+    ///
+    /// Copies share the call. Call \ref WritesDone once all the messages have
+    /// been written; it is called when the last copy is destroyed otherwise.
+    template <typename Request>
+    class client_stream_writer final
+    {
+    public:
+        /// @brief Creates an empty client_stream_writer.
+        client_stream_writer() = default;
+
+        explicit client_stream_writer(boost::intrusive_ptr<detail::client_stream_impl> impl) noexcept
+            : _impl{ std::move(impl) }
+        {}
+
+        /// @brief Returns true if this writer is non-empty; otherwise false.
+        explicit operator bool() const noexcept
+        {
+            return static_cast<bool>(_impl);
+        }
+
+        /// @brief Writes a message to the service.
+        ///
+        /// Messages written while a previous one is still being sent are
+        /// queued; \ref pending_writes tells how many are.
+        ///
+        /// @param written optional callback invoked with whether the message
+        /// has been handed to the transport. Waiting for it before writing
+        /// more applies gRPC flow control to the client.
+        void Write(const Request& msg, const std::function<void(bool)>& written = {})
+        {
+            Write(bonded<Request>{ boost::ref(msg) }, written);
+        }
+
+        /// @brief Writes a message to the service.
+        void Write(const bonded<Request>& msg, const std::function<void(bool)>& written = {})
+        {
+            _impl->Write(detail::Serialize(msg), written);
+        }
+
+        /// @brief Tells the service that no more messages will be written,
+        /// once the queued ones have been sent.
+        void WritesDone()
+        {
+            _impl->WritesDone();
+        }
+
+        /// @brief The number of written messages which have not been handed
+        /// to the transport yet, including the one being sent.
+        std::size_t pending_writes() const
+        {
+            return _impl->pending_writes();
+        }
+
+        /// @brief The client context under which the call is executed.
+        const std::shared_ptr<::grpc::ClientContext>& context() const noexcept
+        {
+            return _impl->context();
+        }
+
+    private:
+        detail::stream_ref<detail::client_stream_impl> _impl;
+    };
+
+} } } //namespace bond::ext::grpc
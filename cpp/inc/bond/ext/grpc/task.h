@@ -0,0 +1,215 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace bond { namespace ext { namespace grpc
+{
+namespace detail
+{
+    struct task_operations
+    {
+        void (*invoke)(void* storage);
+        void (*move)(void* to, void* from);
+        void (*destroy)(void* storage);
+    };
+
+    /// Operations on a callable stored in the buffer of a task.
+    template <typename Func>
+    struct inline_task_operations
+    {
+        static void invoke(void* storage)
+        {
+            (*static_cast<Func*>(storage))();
+        }
+
+        static void move(void* to, void* from)
+        {
+            Func& func = *static_cast<Func*>(from);
+            ::new (to) Func(std::move(func));
+            func.~Func();
+        }
+
+        static void destroy(void* storage)
+        {
+            static_cast<Func*>(storage)->~Func();
+        }
+
+        static const task_operations table;
+    };
+
+    template <typename Func>
+    const task_operations inline_task_operations<Func>::table =
+        { &invoke, &move, &destroy };
+
+    /// Operations on a callable allocated on the heap, whose pointer is
+    /// stored in the buffer of a task.
+    template <typename Func>
+    struct heap_task_operations
+    {
+        static Func*& get(void* storage)
+        {
+            return *static_cast<Func**>(storage);
+        }
+
+        static void invoke(void* storage)
+        {
+            (*get(storage))();
+        }
+
+        static void move(void* to, void* from)
+        {
+            ::new (to) Func*(get(from));
+        }
+
+        static void destroy(void* storage)
+        {
+            delete get(storage);
+        }
+
+        static const task_operations table;
+    };
+
+    template <typename Func>
+    const task_operations heap_task_operations<Func>::table =
+        { &invoke, &move, &destroy };
+
+} // namespace detail
+
+    /// @brief A move-only callable taking no arguments.
+    ///
+    /// Unlike std::function, callables need not be copyable, and callables
+    /// of up to \p Size bytes whose move constructor doesn't throw are
+    /// stored in the task itself instead of on the heap. Larger callables
+    /// are allocated on the heap.
+    template <std::size_t Size>
+    class basic_task
+    {
+        using storage_type = typename std::aligned_storage<(Size < sizeof(void*) ? sizeof(void*) : Size)>::type;
+
+    public:
+        /// @brief Whether callables of type \p Func are stored without
+        /// allocating.
+        template <typename Func>
+        struct is_stored_inline
+            : std::integral_constant<bool,
+                sizeof(Func) <= Size
+                && std::alignment_of<storage_type>::value % std::alignment_of<Func>::value == 0
+                && std::is_nothrow_move_constructible<Func>::value>
+        {};
+
+        /// @brief Creates an empty task.
+        basic_task() noexcept
+            : _ops{ nullptr }
+        {}
+
+        /// @brief Creates an empty task.
+        basic_task(std::nullptr_t) noexcept
+            : basic_task{}
+        {}
+
+        /// @brief Creates a task which invokes a copy of \p callback.
+        template <
+            typename Callback,
+            typename Func = typename std::decay<Callback>::type,
+            typename std::enable_if<
+                !std::is_same<Func, basic_task>::value
+                && !std::is_same<Func, std::nullptr_t>::value>::type* = nullptr>
+        basic_task(Callback&& callback)
+            : _ops{ nullptr }
+        {
+            init<Func>(std::forward<Callback>(callback), is_stored_inline<Func>{});
+        }
+
+        basic_task(basic_task&& other) noexcept
+            : _ops{ other._ops }
+        {
+            if (_ops)
+            {
+                _ops->move(&_storage, &other._storage);
+                other._ops = nullptr;
+            }
+        }
+
+        basic_task& operator=(basic_task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+
+                if (other._ops)
+                {
+                    other._ops->move(&_storage, &other._storage);
+                    _ops = other._ops;
+                    other._ops = nullptr;
+                }
+            }
+
+            return *this;
+        }
+
+        basic_task(const basic_task& other) = delete;
+        basic_task& operator=(const basic_task& other) = delete;
+
+        ~basic_task()
+        {
+            reset();
+        }
+
+        /// @brief Invokes the callable. The task must not be empty.
+        void operator()()
+        {
+            BOOST_ASSERT(_ops);
+            _ops->invoke(&_storage);
+        }
+
+        /// @brief Returns true if this task is non-empty; otherwise false.
+        explicit operator bool() const noexcept
+        {
+            return _ops != nullptr;
+        }
+
+    private:
+        template <typename Func, typename Callback>
+        void init(Callback&& callback, std::true_type /* inline */)
+        {
+            ::new (&_storage) Func(std::forward<Callback>(callback));
+            _ops = &detail::inline_task_operations<Func>::table;
+        }
+
+        template <typename Func, typename Callback>
+        void init(Callback&& callback, std::false_type /* inline */)
+        {
+            ::new (&_storage) Func*(new Func(std::forward<Callback>(callback)));
+            _ops = &detail::heap_task_operations<Func>::table;
+        }
+
+        void reset() noexcept
+        {
+            if (_ops)
+            {
+                _ops->destroy(&_storage);
+                _ops = nullptr;
+            }
+        }
+
+        storage_type _storage;
+        const detail::task_operations* _ops;
+    };
+
+    /// @brief The task type that schedulers are handed callbacks with.
+    ///
+    /// Large enough for the callbacks that Bond-over-gRPC schedules for
+    /// each call, which are therefore scheduled without allocating.
+    using task = basic_task<6 * sizeof(void*)>;
+
+} } } // namespace bond::ext::grpc
@@ -13,11 +13,16 @@
 
 #include <bond/core/config.h>
 
+#include "scheduler.h"
+#include "task.h"
+
 #include <boost/optional.hpp>
 
 #include <windows.h>        // TODO: Avoid including windows.h in public ones
 
+#include <malloc.h>
 #include <memory>
+#include <new>
 #include <system_error>
 #include <type_traits>
 
@@ -85,6 +90,7 @@ namespace bond { namespace ext { namespace grpc
                   _pool{ nullptr, ::CloseThreadpool },
                   _group{ nullptr, ::CloseThreadpoolCleanupGroup }
             {
+                ::InitializeSListHead(&_nodes);
                 ::InitializeThreadpoolEnvironment(&_envInst);
                 _env.reset(&_envInst);
 
@@ -117,6 +123,11 @@ namespace bond { namespace ext { namespace grpc
             {
                 // Wait for all callbacks to return without canceling pending ones.
                 ::CloseThreadpoolCleanupGroupMembers(_group.get(), FALSE, nullptr);
+
+                while (::PSLIST_ENTRY entry = ::InterlockedPopEntrySList(&_nodes))
+                {
+                    ::_aligned_free(entry);
+                }
             }
 
             impl(const impl& other) = delete;
@@ -127,6 +138,67 @@ namespace bond { namespace ext { namespace grpc
             {
                 using Func = typename std::decay<Callback>::type;
 
+                schedule_impl<Func>(
+                    std::forward<Callback>(callback),
+                    std::integral_constant<bool, fits_node<Func>::value>{});
+            }
+
+        private:
+            // Storage for a callback, which is kept for reuse after the callback
+            // has run. It is sized for a task, so that callbacks scheduled through
+            // a Scheduler don't allocate once enough nodes have been created.
+            struct node
+            {
+                ::SLIST_ENTRY entry;
+                impl* owner;
+                std::aligned_storage<sizeof(task)>::type storage;
+            };
+
+            template <typename Func>
+            struct fits_node
+                : std::integral_constant<bool,
+                    sizeof(Func) <= sizeof(node::storage)
+                    && std::alignment_of<decltype(node::storage)>::value % std::alignment_of<Func>::value == 0> {};
+
+            template <typename Func, typename Callback>
+            void schedule_impl(Callback&& callback, std::true_type /*fits_node*/)
+            {
+                node* n = acquire_node();
+                Func* func;
+
+                try
+                {
+                    func = ::new (&n->storage) Func{ std::forward<Callback>(callback) };
+                }
+                catch (...)
+                {
+                    release_node(n);
+                    throw;
+                }
+
+                if (!::TrySubmitThreadpoolCallback(
+                        static_cast<::PTP_SIMPLE_CALLBACK>([](::PTP_CALLBACK_INSTANCE, PVOID context)
+                        {
+                            node* n = static_cast<node*>(context);
+                            Func* func = reinterpret_cast<Func*>(&n->storage);
+
+                            (*func)();
+
+                            func->~Func();
+                            n->owner->release_node(n);
+                        }),
+                        n,
+                        _env.get()))
+                {
+                    func->~Func();
+                    release_node(n);
+                    detail::Win32Exception("Failed to submit thread pool callback.");
+                }
+            }
+
+            template <typename Func, typename Callback>
+            void schedule_impl(Callback&& callback, std::false_type /*fits_node*/)
+            {
                 std::unique_ptr<Func> func{ new Func{ std::forward<Callback>(callback) } };
 
                 if (!::TrySubmitThreadpoolCallback(
@@ -143,7 +215,30 @@ namespace bond { namespace ext { namespace grpc
                 func.release();
             }
 
-        private:
+            node* acquire_node()
+            {
+                if (::PSLIST_ENTRY entry = ::InterlockedPopEntrySList(&_nodes))
+                {
+                    return CONTAINING_RECORD(entry, node, entry);
+                }
+
+                // SLIST_ENTRY must be aligned on MEMORY_ALLOCATION_ALIGNMENT.
+                void* p = ::_aligned_malloc(sizeof(node), MEMORY_ALLOCATION_ALIGNMENT);
+                if (!p)
+                {
+                    throw std::bad_alloc{};
+                }
+
+                node* n = static_cast<node*>(p);
+                n->owner = this;
+                return n;
+            }
+
+            void release_node(node* n) noexcept
+            {
+                ::InterlockedPushEntrySList(&_nodes, &n->entry);
+            }
+
             void SetThreadCount(DWORD minThreads, DWORD maxThreads)
             {
                 if (!::SetThreadpoolThreadMinimum(_pool.get(), static_cast<DWORD>(minThreads)))
@@ -154,6 +249,8 @@ namespace bond { namespace ext { namespace grpc
                 ::SetThreadpoolThreadMaximum(_pool.get(), static_cast<DWORD>(maxThreads));
             }
 
+            // Nodes of callbacks which have run, available for reuse.
+            ::SLIST_HEADER _nodes;
             ::TP_CALLBACK_ENVIRON _envInst;
             std::unique_ptr<::TP_CALLBACK_ENVIRON, decltype(&::DestroyThreadpoolEnvironment)> _env;
             std::unique_ptr<::TP_POOL, decltype(&::CloseThreadpool)> _pool;
@@ -169,6 +266,10 @@ namespace bond { namespace ext { namespace grpc
         std::shared_ptr<impl> _impl;
     };
 
+    template <>
+    struct is_task_scheduler<win_thread_pool>
+        : std::true_type {};
+
 } } } // namespace bond::ext::grpc
 
 #else // _WIN32_WINNT < 0x0600
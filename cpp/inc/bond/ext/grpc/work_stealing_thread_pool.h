@@ -0,0 +1,368 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "detail/cpu_affinity.h"
+#include "exception.h"
+#include "scheduler.h"
+#include "task.h"
+
+#include <boost/assert.hpp>
+#include <boost/thread/scoped_thread.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace bond { namespace ext { namespace grpc
+{
+namespace detail
+{
+    /// @brief A double-ended queue of tasks stored in a ring buffer which
+    /// only grows, so that pushing and popping don't allocate once it has
+    /// reached its working size.
+    class task_deque
+    {
+    public:
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+        void push_back(task&& t)
+        {
+            if (_size == _buffer.size())
+            {
+                grow();
+            }
+
+            _buffer[(_head + _size) & (_buffer.size() - 1)] = std::move(t);
+            ++_size;
+        }
+
+        task pop_back()
+        {
+            BOOST_ASSERT(!empty());
+            --_size;
+            return std::move(_buffer[(_head + _size) & (_buffer.size() - 1)]);
+        }
+
+        task pop_front()
+        {
+            BOOST_ASSERT(!empty());
+            task t = std::move(_buffer[_head]);
+            _head = (_head + 1) & (_buffer.size() - 1);
+            --_size;
+            return t;
+        }
+
+    private:
+        void grow()
+        {
+            // Keep the capacity a power of two, so that indices wrap with a mask.
+            std::vector<task> buffer(_buffer.empty() ? 64 : _buffer.size() * 2);
+
+            for (std::size_t i = 0; i < _size; ++i)
+            {
+                buffer[i] = std::move(_buffer[(_head + i) & (_buffer.size() - 1)]);
+            }
+
+            _buffer.swap(buffer);
+            _head = 0;
+        }
+
+        std::vector<task> _buffer;
+        std::size_t _head = 0;
+        std::size_t _size = 0;
+    };
+
+} // namespace detail
+
+    /// @brief Thread pool in which each thread has its own queue of
+    /// callbacks and steals from the others when it runs out.
+    ///
+    /// Callbacks scheduled from one of the threads of the pool, e.g. by
+    /// another callback, are queued on that thread and the most recently
+    /// queued one runs first. Callbacks scheduled from other threads, such as
+    /// the gRPC polling threads, are spread over the queues. An idle thread
+    /// takes the oldest callback from the queue of a random other thread.
+    /// Unlike with \ref basic_thread_pool, threads don't contend on a single
+    /// queue.
+    ///
+    /// Copies share the pool. Destroying the last copy waits for all the
+    /// scheduled callbacks to finish.
+    class work_stealing_thread_pool
+    {
+    public:
+        /// @brief Constructs and starts a thread pool with number of threads equal
+        /// to CPU/cores available.
+        ///
+        /// @throws InvalidThreadCount when std::thread::hardware_concurrency returns 0.
+        work_stealing_thread_pool()
+            : work_stealing_thread_pool{ std::thread::hardware_concurrency() }
+        {}
+
+        /// @brief Constructs and starts a thread pool with the specified number of
+        /// threads.
+        ///
+        /// @param cpus the CPUs to pin the threads to. The i-th thread is
+        /// pinned to <tt>cpus[i % cpus.size()]</tt>. If empty, the threads
+        /// are not pinned.
+        ///
+        /// @throws InvalidThreadCount when 0 is specified.
+        explicit work_stealing_thread_pool(unsigned int numThreads, std::vector<unsigned int> cpus = {})
+            : _impl{ numThreads != 0
+                ? std::make_shared<impl>(numThreads, std::move(cpus))
+                : throw InvalidThreadCount{} }
+        {}
+
+        /// @brief Schedules a callback for execution.
+        ///
+        /// @param callback: functor object to be scheduled.
+        template <typename Callback>
+        void operator()(Callback&& callback)
+        {
+            _impl->schedule(task{ std::forward<Callback>(callback) });
+        }
+
+    private:
+        class impl
+        {
+        public:
+            impl(unsigned int numThreads, std::vector<unsigned int> cpus)
+                : _queued{ 0 },
+                  _sleeping{ 0 },
+                  _next{ 0 },
+                  _stopping{ false }
+            {
+                _workers.reserve(numThreads);
+
+                for (unsigned int i = 0; i < numThreads; ++i)
+                {
+                    _workers.emplace_back(new worker{ *this, i });
+                }
+
+                _threads.reserve(numThreads);
+
+                try
+                {
+                    for (unsigned int i = 0; i < numThreads; ++i)
+                    {
+                        const bool pin = !cpus.empty();
+                        const unsigned int cpu = pin ? cpus[i % cpus.size()] : 0;
+                        worker& w = *_workers[i];
+
+                        _threads.emplace_back([&w, pin, cpu]
+                        {
+                            if (pin)
+                            {
+                                detail::pin_current_thread(cpu);
+                            }
+
+                            w.run();
+                        });
+                    }
+                }
+                catch (...)
+                {
+                    stop();
+                    throw;
+                }
+            }
+
+            impl(const impl& other) = delete;
+            impl& operator=(const impl& other) = delete;
+
+            ~impl()
+            {
+                stop();
+            }
+
+            void schedule(task&& t)
+            {
+                worker* current = current_worker();
+
+                if (current && &current->pool == this)
+                {
+                    current->push(std::move(t));
+                }
+                else
+                {
+                    const std::size_t index = _next.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+                    _workers[index]->push(std::move(t));
+                }
+
+                // Pairs with the check in worker::run that no callback is
+                // queued after announcing that the worker goes to sleep: either
+                // that check sees the callback, or the sleeper is seen here.
+                _queued.fetch_add(1);
+
+                if (_sleeping.load() != 0)
+                {
+                    std::lock_guard<std::mutex> lock{ _sleepMutex };
+                    _wake.notify_one();
+                }
+            }
+
+        private:
+            void stop()
+            {
+                {
+                    std::lock_guard<std::mutex> lock{ _sleepMutex };
+                    _stopping = true;
+                }
+
+                _wake.notify_all();
+
+                // Joins the threads, which exit once all the callbacks have run.
+                _threads.clear();
+            }
+
+            class worker
+            {
+            public:
+                worker(impl& owner, unsigned int index)
+                    : pool(owner),
+                      _index{ index },
+                      _random{ index * 2654435761u + 1 }
+                {}
+
+                void push(task&& t)
+                {
+                    std::lock_guard<std::mutex> lock{ _mutex };
+                    _tasks.push_back(std::move(t));
+                }
+
+                void run()
+                {
+                    current_worker() = this;
+
+                    for (;;)
+                    {
+                        task t = pop_back();
+
+                        if (!t)
+                        {
+                            t = steal();
+                        }
+
+                        if (t)
+                        {
+                            pool._queued.fetch_sub(1, std::memory_order_relaxed);
+                            t();
+                            continue;
+                        }
+
+                        std::unique_lock<std::mutex> lock{ pool._sleepMutex };
+
+                        pool._sleeping.fetch_add(1);
+
+                        if (pool._queued.load() == 0)
+                        {
+                            if (pool._stopping)
+                            {
+                                pool._sleeping.fetch_sub(1);
+                                break;
+                            }
+
+                            pool._wake.wait(lock);
+                        }
+
+                        pool._sleeping.fetch_sub(1);
+                    }
+
+                    current_worker() = nullptr;
+                }
+
+                impl& pool;
+
+            private:
+                task pop_back()
+                {
+                    std::lock_guard<std::mutex> lock{ _mutex };
+                    return _tasks.empty() ? task{} : _tasks.pop_back();
+                }
+
+                task pop_front()
+                {
+                    std::lock_guard<std::mutex> lock{ _mutex };
+                    return _tasks.empty() ? task{} : _tasks.pop_front();
+                }
+
+                /// Takes the oldest callback of the first worker which has
+                /// one, starting from a random one.
+                task steal()
+                {
+                    const std::size_t count = pool._workers.size();
+
+                    if (count == 1)
+                    {
+                        return {};
+                    }
+
+                    // xorshift32
+                    _random ^= _random << 13;
+                    _random ^= _random >> 17;
+                    _random ^= _random << 5;
+
+                    const std::size_t start = _random % count;
+
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        const std::size_t victim = (start + i) % count;
+
+                        if (victim != _index)
+                        {
+                            if (task t = pool._workers[victim]->pop_front())
+                            {
+                                return t;
+                            }
+                        }
+                    }
+
+                    return {};
+                }
+
+                const unsigned int _index;
+                uint32_t _random;
+                std::mutex _mutex;
+                detail::task_deque _tasks;
+            };
+
+            static worker*& current_worker()
+            {
+                static thread_local worker* current = nullptr;
+                return current;
+            }
+
+            /// The number of callbacks in the queues of the workers.
+            std::atomic<std::size_t> _queued;
+            /// The number of workers waiting for callbacks to be scheduled.
+            std::atomic<std::size_t> _sleeping;
+            /// Picks the queue of the next callback scheduled from outside
+            /// of the pool.
+            std::atomic<std::size_t> _next;
+            std::mutex _sleepMutex;
+            std::condition_variable _wake;
+            bool _stopping;
+            std::vector<std::unique_ptr<worker>> _workers;
+            std::vector<boost::scoped_thread<>> _threads;
+        };
+
+        std::shared_ptr<impl> _impl;
+    };
+
+    template <>
+    struct is_task_scheduler<work_stealing_thread_pool>
+        : std::true_type {};
+
+} } } // namespace bond::ext::grpc
@@ -17,6 +17,7 @@
 #include <boost/noncopyable.hpp>
 #include <boost/static_assert.hpp>
 
+#include <algorithm>
 #include <cstring>
 
 /*
@@ -146,6 +147,28 @@ namespace bond
 template <typename BufferT>
 class CompactBinaryWriter;
 
+
+namespace detail
+{
+
+template <typename Buffer, typename Enable = void> struct
+implements_get_position
+    : std::false_type {};
+
+
+// Input stream reporting its current offset, see InputBuffer::GetPosition.
+template <typename Buffer> struct
+implements_get_position<Buffer,
+#ifdef BOND_NO_SFINAE_EXPR
+    typename boost::enable_if<check_method<uint64_t (Buffer::*)() const, &Buffer::GetPosition> >::type>
+#else
+    detail::mpl::void_t<decltype(std::declval<const Buffer&>().GetPosition())>>
+#endif
+    : std::true_type {};
+
+} // namespace detail
+
+
 /// @brief Reader for Compact Binary Protocol
 template <typename BufferT>
 class CompactBinaryReader
@@ -162,7 +185,8 @@ public:
     CompactBinaryReader(typename boost::call_traits<Buffer>::param_type input,
                         uint16_t version_value = default_version<CompactBinaryReader>::value)
         : _input(input),
-          _version(version_value)
+          _version(version_value),
+          _skipped(nullptr)
     {
         BOOST_ASSERT(protocol_has_multiple_versions<CompactBinaryReader>::value
             ? _version <= CompactBinaryReader::version
@@ -176,7 +200,8 @@ public:
     /// @brief Copy constructor
     CompactBinaryReader(const CompactBinaryReader& that) BOND_NOEXCEPT
         : _input(that._input),
-          _version(that._version)
+          _version(that._version),
+          _skipped(that._skipped)
     {}
 
 
@@ -203,6 +228,22 @@ public:
     }
 
 
+    /// @brief Count the bytes of data skipped by the reader
+    ///
+    /// When set, the size of every value the reader skips, e.g. unknown
+    /// fields ignored during deserialization or the data of bonded<T>
+    /// fields, is added to the counter. The counter is shared by the copies
+    /// of the reader, including the ones held by bonded<T> objects, and must
+    /// outlive them. Pass nullptr to stop counting.
+    void SetSkipCounter(uint64_t* counter)
+    {
+        BOOST_STATIC_ASSERT_MSG(detail::implements_get_position<Buffer>::value,
+            "Counting skipped bytes requires GetPosition for the buffer");
+
+        _skipped = counter;
+    }
+
+
     bool ReadVersion()
     {
         uint16_t magic_value;
@@ -327,6 +368,42 @@ public:
     }
 
 
+    // Read array of floating point or single byte values
+    template <typename T>
+    typename boost::enable_if_c<std::is_floating_point<T>::value
+                             || (std::is_arithmetic<T>::value && sizeof(T) == 1)>::type
+    Read(T* values, uint32_t size)
+    {
+        _input.Read(values, detail::checked_multiply(size, static_cast<uint8_t>(sizeof(T))));
+    }
+
+    // Read array of unsigned integers
+    template <typename T>
+    typename boost::enable_if_c<std::is_unsigned<T>::value && (sizeof(T) > 1)>::type
+    Read(T* values, uint32_t size)
+    {
+        ReadVariableUnsigned(_input, values, size);
+    }
+
+    // Read array of signed integers
+    template <typename T>
+    typename boost::enable_if_c<is_signed_int<T>::value && (sizeof(T) > 1)>::type
+    Read(T* values, uint32_t size)
+    {
+        typedef typename std::make_unsigned<T>::type unsigned_type;
+
+        // Decode in place; signed and unsigned variants of a type may alias.
+        unsigned_type* const unsigned_values = reinterpret_cast<unsigned_type*>(values);
+
+        ReadVariableUnsigned(_input, unsigned_values, size);
+
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            values[i] = DecodeZigZag(unsigned_values[i]);
+        }
+    }
+
+
     // Read for enums
     template <typename T>
     typename boost::enable_if<std::is_enum<T> >::type
@@ -382,21 +459,62 @@ public:
     template <typename T>
     void Skip()
     {
-        SkipType<get_type_id<T>::value>();
+        if (_skipped)
+            CountedSkip(get_type_id<T>::value, detail::implements_get_position<Buffer>());
+        else
+            SkipType<get_type_id<T>::value>();
     }
 
     template <typename T>
     void Skip(const bonded<T, CompactBinaryReader&>&)
     {
-        SkipType<bond::BT_STRUCT>();
+        Skip(bond::BT_STRUCT);
     }
 
     void Skip(BondDataType type)
     {
-        SkipType(type);
+        if (_skipped)
+            CountedSkip(type, detail::implements_get_position<Buffer>());
+        else
+            SkipType(type);
     }
 
 protected:
+    BOND_NO_INLINE void CountedSkip(BondDataType type, std::true_type)
+    {
+        const uint64_t begin = _input.GetPosition();
+
+        SkipType(type);
+
+        *_skipped += _input.GetPosition() - begin;
+    }
+
+    void CountedSkip(BondDataType type, std::false_type)
+    {
+        SkipType(type);
+    }
+
+    // Size of values of fixed-width types, 0 for other types
+    static uint32_t FixedWidth(BondDataType type)
+    {
+        switch (type)
+        {
+            case BT_BOOL:
+            case BT_UINT8:
+            case BT_INT8:
+                return sizeof(uint8_t);
+
+            case BT_FLOAT:
+                return sizeof(float);
+
+            case BT_DOUBLE:
+                return sizeof(double);
+
+            default:
+                return 0;
+        }
+    }
+
 #if defined(_MSC_VER) && (_MSC_VER < 1900)
     // Using BondDataType directly in non-trivial boolean template checks fails on VC12.
     using BT = std::underlying_type<BondDataType>::type;
@@ -414,10 +532,10 @@ protected:
     template <BT T>
     typename boost::enable_if_c<(T == BT_UINT16 || T == BT_UINT32 || T == BT_UINT64
                                 || T == BT_INT16 || T == BT_INT32 || T == BT_INT64)>::type
-    SkipType()
+    SkipType(uint32_t size = 1)
     {
-        uint64_t value;
-        Read(value);
+        // Variable encoded integers are skipped without decoding them
+        SkipVariableUnsigned(_input, size);
     }
 
     template <BT T>
@@ -474,11 +592,24 @@ protected:
         uint32_t                                size;
 
         ReadContainerBegin(size, element_type);
-        for (int64_t i = 0; i < size; ++i)
+
+        const uint32_t key_width = FixedWidth(element_type.first);
+        const uint32_t value_width = FixedWidth(element_type.second);
+
+        if (key_width && value_width)
         {
-            SkipType(element_type.first);
-            SkipType(element_type.second);
+            // Maps of fixed-width types are skipped at once
+            _input.Skip(detail::checked_multiply(size, static_cast<uint8_t>(key_width + value_width)));
         }
+        else
+        {
+            for (int64_t i = 0; i < size; ++i)
+            {
+                SkipType(element_type.first);
+                SkipType(element_type.second);
+            }
+        }
+
         ReadContainerEnd();
     }
 
@@ -551,9 +682,7 @@ protected:
     }
 
     template <BT T>
-    typename boost::enable_if_c<(T == BT_UINT16 || T == BT_UINT32 || T == BT_UINT64
-                                || T == BT_INT16 || T == BT_INT32 || T == BT_INT64
-                                || T == BT_STRING || T == BT_WSTRING
+    typename boost::enable_if_c<(T == BT_STRING || T == BT_WSTRING
                                 || T == BT_SET || T == BT_LIST || T == BT_MAP)>::type
     SkipType(uint32_t size)
     {
@@ -619,6 +748,7 @@ protected:
 
     Buffer  _input;
     uint16_t _version;
+    uint64_t* _skipped;
 
     template <typename Input, typename Output>
     friend
@@ -630,6 +760,29 @@ template <typename BufferT>
 BOND_CONSTEXPR_OR_CONST uint16_t CompactBinaryReader<BufferT>::magic;
 
 
+namespace detail
+{
+
+template <typename Buffer, typename Enable = void> struct
+implements_reserve
+    : std::false_type {};
+
+
+// Output stream allowing to reserve space at the current position and
+// back-patch it later, see OutputMemoryStream::Reserve.
+template <typename Buffer> struct
+implements_reserve<Buffer,
+#ifdef BOND_NO_SFINAE_EXPR
+    typename boost::enable_if<check_method<char* (Buffer::*)(uint32_t), &Buffer::Reserve> >::type>
+#else
+    detail::mpl::void_t<decltype(std::declval<Buffer>().Reserve(std::declval<uint32_t>())),
+                        decltype(std::declval<Buffer>().GetPosition())>>
+#endif
+    : std::true_type {};
+
+} // namespace detail
+
+
 class CompactBinaryCounter
 {
     template <typename Buffer>
@@ -669,11 +822,20 @@ public:
 
 
     /// @brief Construct from output buffer/stream.
+    ///
+    /// If singlePass is true and the output stream supports back-patching,
+    /// struct lengths in version 2 are written in a single pass as fixed-width
+    /// variable encoded integers, instead of being computed in a separate
+    /// pass over the data. This trades up to 4 extra bytes per struct for
+    /// serialization speed; the payload can be read by any v2 reader.
+    /// Otherwise the writer falls back to the double-pass serialization.
     CompactBinaryWriter(Buffer& output,
-                        uint16_t version = default_version<Reader>::value)
+                        uint16_t version = default_version<Reader>::value,
+                        bool singlePass = false)
         : _output(output),
           _it(NULL),
-          _version(version)
+          _version(version),
+          _singlePass(singlePass && detail::implements_reserve<Buffer>::value)
     {
         BOOST_ASSERT(protocol_has_multiple_versions<Reader>::value
             ? _version <= Reader::version
@@ -684,7 +846,8 @@ public:
     CompactBinaryWriter(Counter& output,
                         const CompactBinaryWriter<T>& pass1)
         : _output(output),
-          _version(pass1._version)
+          _version(pass1._version),
+          _singlePass(false)
     {}
 
 
@@ -698,7 +861,7 @@ public:
 
     bool NeedPass0()
     {
-        return v2 == _version && !_it;
+        return v2 == _version && !_it && !_singlePass;
     }
 
 
@@ -827,6 +990,50 @@ public:
         WriteVariableUnsigned(_output, EncodeZigZag(value));
     }
 
+    // Write array of floating point or single byte values
+    template <typename T>
+    typename boost::enable_if_c<std::is_floating_point<T>::value
+                             || (std::is_arithmetic<T>::value && sizeof(T) == 1)>::type
+    Write(const T* values, uint32_t size)
+    {
+        _output.Write(values, detail::checked_multiply(size, static_cast<uint8_t>(sizeof(T))));
+    }
+
+    // Write array of unsigned integers
+    template <typename T>
+    typename boost::enable_if_c<std::is_unsigned<T>::value && (sizeof(T) > 1)>::type
+    Write(const T* values, uint32_t size)
+    {
+        WriteVariableUnsigned(_output, values, size);
+    }
+
+    // Write array of signed integers
+    template <typename T>
+    typename boost::enable_if_c<is_signed_int<T>::value && (sizeof(T) > 1)>::type
+    Write(const T* values, uint32_t size)
+    {
+        typedef typename std::make_unsigned<T>::type unsigned_type;
+
+        // Encode in chunks to avoid modifying the values or allocating
+        const uint32_t chunk_size = 256;
+        unsigned_type chunk[chunk_size];
+
+        while (size != 0)
+        {
+            const uint32_t count = (std::min)(size, chunk_size);
+
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                chunk[i] = EncodeZigZag(values[i]);
+            }
+
+            WriteVariableUnsigned(_output, static_cast<const unsigned_type*>(chunk), count);
+
+            values += count;
+            size -= count;
+        }
+    }
+
     // Write for enums
     template <typename T>
     typename boost::enable_if<std::is_enum<T> >::type
@@ -890,24 +1097,86 @@ protected:
     }
 
     template<typename T>
-    void LengthBegin(T&)
+    void LengthBegin(T& output)
     {
         if (v2 == _version)
         {
-            Write(*_it++);
+            if (_singlePass)
+            {
+                ReserveLength(output);
+            }
+            else
+            {
+                Write(*_it++);
+            }
         }
     }
 
     template<typename T>
-    void LengthEnd(T&)
-    {}
+    void LengthEnd(T& output)
+    {
+        if (v2 == _version && _singlePass)
+        {
+            PatchLength(output);
+        }
+    }
+
+    // Reserves space for a fixed-width length and temporarily stores in it
+    // the stream position at the beginning of the struct.
+    template<typename T>
+    typename boost::enable_if<detail::implements_reserve<T> >::type
+    ReserveLength(T& output)
+    {
+        char* slot = output.Reserve(c_lengthSlotSize);
+        const uint32_t position = output.GetPosition();
+
+        std::memcpy(slot, &position, sizeof(position));
+        _slots.push(slot);
+    }
+
+    template<typename T>
+    typename boost::enable_if<detail::implements_reserve<T> >::type
+    PatchLength(T& output)
+    {
+        char* slot = _slots.pop();
+        uint32_t length;
+
+        std::memcpy(&length, slot, sizeof(length));
+        length = output.GetPosition() - length;
+
+        // Padded variable encoding: continuation bit set in all but last byte.
+        for (uint32_t i = 0; i < c_lengthSlotSize - 1; ++i, length >>= 7)
+        {
+            slot[i] = static_cast<char>((length & 0x7f) | 0x80);
+        }
+
+        slot[c_lengthSlotSize - 1] = static_cast<char>(length);
+    }
+
+    template<typename T>
+    typename boost::disable_if<detail::implements_reserve<T> >::type
+    ReserveLength(T&)
+    {
+        BOOST_ASSERT(false);
+    }
+
+    template<typename T>
+    typename boost::disable_if<detail::implements_reserve<T> >::type
+    PatchLength(T&)
+    {
+        BOOST_ASSERT(false);
+    }
+
+    static const uint32_t c_lengthSlotSize = 5;
 
 protected:
     Buffer&                         _output;
     const uint32_t*                 _it;
     uint16_t                        _version;
+    bool                            _singlePass;
     detail::SimpleArray<uint32_t>   _stack;
     detail::SimpleArray<uint32_t>   _lengths;
+    detail::SimpleArray<char*>      _slots;
 
     template <typename Input, typename Output>
     friend
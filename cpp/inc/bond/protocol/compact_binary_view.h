@@ -0,0 +1,517 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "compact_binary.h"
+
+#include <bond/core/blob.h>
+#include <bond/core/bond.h>
+#include <bond/stream/input_buffer.h>
+
+#include <boost/utility/enable_if.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace bond
+{
+
+class CompactBinaryListView;
+
+namespace detail
+{
+
+typedef CompactBinaryReader<InputBuffer> CompactBinaryViewReader;
+
+
+// Offset of the current position of the reader in the data
+inline uint32_t CurrentOffset(const blob& data, const CompactBinaryViewReader& reader)
+{
+    return data.length() - GetCurrentBuffer(reader.GetBuffer()).length();
+}
+
+
+template <typename T>
+typename boost::enable_if<has_schema<T> >::type
+inline ReadViewValue(CompactBinaryViewReader& reader, T& var)
+{
+    bonded<T, CompactBinaryViewReader&>(reader).Deserialize(var);
+}
+
+
+template <typename T>
+typename boost::disable_if<has_schema<T> >::type
+inline ReadViewValue(CompactBinaryViewReader& reader, T& var)
+{
+    value<T, CompactBinaryViewReader&>(reader).Deserialize(var);
+}
+
+} // namespace detail
+
+
+/// @brief Read-only random access view of a struct serialized in Compact Binary
+///
+/// The view indexes the offsets of the fields of the struct in one pass over
+/// the payload, skipping the values, including nested structs, using the
+/// length prefixes of Compact Binary v2. Fields can then be read in any order
+/// without parsing their siblings. Nested structs and lists are indexed only
+/// when a view of them is requested, so reading a few fields of a large
+/// payload only touches the data on the path to these fields.
+///
+/// The view references the memory of the payload. Fields of the base structs
+/// are accessible by their ids, unless a field of a derived struct has the
+/// same id.
+class CompactBinaryView
+{
+public:
+    /// @brief Default constructor
+    CompactBinaryView()
+        : _version(v2)
+    {}
+
+    /// @brief Index a struct serialized in Compact Binary
+    explicit CompactBinaryView(const blob& data, uint16_t version = v2)
+        : _data(data),
+          _version(version)
+    {
+        Index();
+    }
+
+    /// @brief Check if the struct contains a field with the specified id
+    bool Has(uint16_t id) const
+    {
+        return Find(id) != nullptr;
+    }
+
+    /// @brief Type of the field with the specified id
+    ///
+    /// Returns BT_UNAVAILABLE if the struct doesn't contain the field.
+    BondDataType GetFieldType(uint16_t id) const
+    {
+        const Field* field = Find(id);
+
+        return field ? field->type : BT_UNAVAILABLE;
+    }
+
+    /// @brief Deserialize the field with the specified id
+    ///
+    /// Returns false if the struct doesn't contain the field or if the type
+    /// of the field doesn't match the type T.
+    template <typename T>
+    bool GetField(uint16_t id, T& var) const
+    {
+        const Field* field = Find(id, get_type_id<T>::value);
+
+        if (!field)
+            return false;
+
+        detail::CompactBinaryViewReader reader(GetReader(field->offset));
+        detail::ReadViewValue(reader, var);
+        return true;
+    }
+
+    /// @brief Get the struct field with the specified id as bonded<T>
+    template <typename T>
+    bool GetField(uint16_t id, bonded<T>& var) const
+    {
+        const Field* field = Find(id, BT_STRUCT);
+
+        if (!field)
+            return false;
+
+        var = bonded<T>(GetReader(field->offset));
+        return true;
+    }
+
+    /// @brief Get a view of the struct field with the specified id
+    bool GetField(uint16_t id, CompactBinaryView& view) const
+    {
+        const Field* field = Find(id, BT_STRUCT);
+
+        if (!field)
+            return false;
+
+        view = CompactBinaryView(_data.range(field->offset), _version);
+        return true;
+    }
+
+    /// @brief Get a view of the list or set field with the specified id
+    bool GetField(uint16_t id, CompactBinaryListView& view) const;
+
+private:
+    struct Field
+    {
+        uint16_t id;
+        uint16_t level;
+        BondDataType type;
+        uint32_t offset;
+
+        // Fields of derived structs are ordered before fields of their bases
+        bool operator<(const Field& rhs) const
+        {
+            return id < rhs.id || (id == rhs.id && level > rhs.level);
+        }
+    };
+
+    void Index()
+    {
+        detail::CompactBinaryViewReader reader(_data, _version);
+        uint16_t level = 0;
+
+        reader.ReadStructBegin();
+
+        for (;;)
+        {
+            Field field;
+
+            reader.ReadFieldBegin(field.type, field.id);
+
+            if (field.type == BT_STOP)
+                break;
+
+            if (field.type == BT_STOP_BASE)
+            {
+                ++level;
+                continue;
+            }
+
+            field.level = level;
+            field.offset = detail::CurrentOffset(_data, reader);
+            _fields.push_back(field);
+
+            reader.Skip(field.type);
+            reader.ReadFieldEnd();
+        }
+
+        reader.ReadStructEnd();
+
+        std::sort(_fields.begin(), _fields.end());
+    }
+
+    const Field* Find(uint16_t id) const
+    {
+        auto it = std::lower_bound(_fields.begin(), _fields.end(), id,
+            [](const Field& field, uint16_t value) { return field.id < value; });
+
+        return it != _fields.end() && it->id == id ? &*it : nullptr;
+    }
+
+    const Field* Find(uint16_t id, BondDataType type) const
+    {
+        const Field* field = Find(id);
+
+        return field && field->type == type ? field : nullptr;
+    }
+
+    detail::CompactBinaryViewReader GetReader(uint32_t offset) const
+    {
+        return detail::CompactBinaryViewReader(_data.range(offset), _version);
+    }
+
+    blob _data;
+    uint16_t _version;
+    std::vector<Field> _fields;
+};
+
+
+/// @brief Read-only random access view of a list or set serialized in Compact Binary
+///
+/// Elements of fixed-width types are located by their index; for other types
+/// the offsets of the elements are indexed in one pass over the container,
+/// skipping structs using the length prefixes of Compact Binary v2.
+class CompactBinaryListView
+{
+public:
+    /// @brief Default constructor
+    CompactBinaryListView()
+        : _version(v2),
+          _size(0),
+          _type(BT_UNAVAILABLE),
+          _begin(0),
+          _width(0)
+    {}
+
+    /// @brief Index a list or set serialized in Compact Binary
+    explicit CompactBinaryListView(const blob& data, uint16_t version = v2)
+        : _data(data),
+          _version(version),
+          _size(0),
+          _type(BT_UNAVAILABLE)
+    {
+        Index();
+    }
+
+    /// @brief Number of elements
+    uint32_t size() const
+    {
+        return _size;
+    }
+
+    /// @brief Type of the elements
+    BondDataType GetElementType() const
+    {
+        return _type;
+    }
+
+    /// @brief Deserialize the element with the specified index
+    ///
+    /// Returns false if the index is out of range or if the type of the
+    /// elements doesn't match the type T.
+    template <typename T>
+    bool GetElement(uint32_t index, T& var) const
+    {
+        if (index >= _size || _type != get_type_id<T>::value)
+            return false;
+
+        detail::CompactBinaryViewReader reader(GetReader(index));
+        detail::ReadViewValue(reader, var);
+        return true;
+    }
+
+    /// @brief Get the struct element with the specified index as bonded<T>
+    template <typename T>
+    bool GetElement(uint32_t index, bonded<T>& var) const
+    {
+        if (index >= _size || _type != BT_STRUCT)
+            return false;
+
+        var = bonded<T>(GetReader(index));
+        return true;
+    }
+
+    /// @brief Get a view of the struct element with the specified index
+    bool GetElement(uint32_t index, CompactBinaryView& view) const
+    {
+        if (index >= _size || _type != BT_STRUCT)
+            return false;
+
+        view = CompactBinaryView(_data.range(Offset(index)), _version);
+        return true;
+    }
+
+    /// @brief Get a view of the list or set element with the specified index
+    bool GetElement(uint32_t index, CompactBinaryListView& view) const
+    {
+        if (index >= _size || (_type != BT_LIST && _type != BT_SET))
+            return false;
+
+        view = CompactBinaryListView(_data.range(Offset(index)), _version);
+        return true;
+    }
+
+    /// @brief Deserialize a range of consecutive elements
+    ///
+    /// Deserializes count elements, starting with the element with the
+    /// specified index, into the range starting at the forward iterator it.
+    /// The elements are read sequentially with one reader. Returns false if
+    /// the range is out of bounds or if the type of the elements doesn't
+    /// match the value type of the iterator.
+    template <typename Iterator>
+    bool GetElements(uint32_t index, uint32_t count, Iterator it) const
+    {
+        typedef typename std::iterator_traits<Iterator>::value_type T;
+
+        if (index > _size || count > _size - index || _type != get_type_id<T>::value)
+            return false;
+
+        if (count)
+        {
+            detail::CompactBinaryViewReader reader(GetReader(index));
+
+            for (; count != 0; --count, ++it)
+                detail::ReadViewValue(reader, *it);
+        }
+
+        return true;
+    }
+
+private:
+    // Size of elements of fixed-width types, 0 for other types
+    static uint32_t FixedWidth(BondDataType type)
+    {
+        switch (type)
+        {
+            case BT_BOOL:
+            case BT_UINT8:
+            case BT_INT8:
+                return sizeof(uint8_t);
+
+            case BT_FLOAT:
+                return sizeof(float);
+
+            case BT_DOUBLE:
+                return sizeof(double);
+
+            default:
+                return 0;
+        }
+    }
+
+    void Index()
+    {
+        detail::CompactBinaryViewReader reader(_data, _version);
+
+        reader.ReadContainerBegin(_size, _type);
+
+        _begin = detail::CurrentOffset(_data, reader);
+        _width = FixedWidth(_type);
+
+        if (_width)
+        {
+            // Elements are located by their index, as long as they are all
+            // in the payload.
+            if (_data.length() - _begin < static_cast<uint64_t>(_size) * _width)
+            {
+                BOND_THROW(StreamException, "Compact Binary list of " << _size
+                    << " elements is truncated, length: " << _data.length() - _begin);
+            }
+        }
+        else
+        {
+            _offsets.reserve((std::min)(_size, _data.length() - _begin));
+
+            for (uint32_t i = 0; i < _size; ++i)
+            {
+                _offsets.push_back(detail::CurrentOffset(_data, reader));
+                reader.Skip(_type);
+            }
+        }
+    }
+
+    uint32_t Offset(uint32_t index) const
+    {
+        return _width ? _begin + index * _width : _offsets[index];
+    }
+
+    detail::CompactBinaryViewReader GetReader(uint32_t index) const
+    {
+        return detail::CompactBinaryViewReader(_data.range(Offset(index)), _version);
+    }
+
+    blob _data;
+    uint16_t _version;
+    uint32_t _size;
+    BondDataType _type;
+    uint32_t _begin;
+    uint32_t _width;
+    std::vector<uint32_t> _offsets;
+};
+
+
+inline bool CompactBinaryView::GetField(uint16_t id, CompactBinaryListView& view) const
+{
+    const Field* field = Find(id);
+
+    if (!field || (field->type != BT_LIST && field->type != BT_SET))
+        return false;
+
+    view = CompactBinaryListView(_data.range(field->offset), _version);
+    return true;
+}
+
+
+/// @brief Deserialize the elements of a list concurrently
+///
+/// The vector is resized to the size of the list and split into ranges of
+/// up to grain consecutive elements. Each range is deserialized by a task
+/// passed to the executor, a callable accepting std::function<void()>, which
+/// may run the task on any thread, including the calling one (for example
+/// bond::ext::grpc::thread_pool). The function returns when all the tasks
+/// have completed and rethrows the first exception thrown by any of them.
+///
+/// The offsets of the elements are found when the view is created; with
+/// Compact Binary v2 this skips over structs using their length prefixes.
+/// Returns false if the type of the elements doesn't match the type T.
+template <typename T, typename A, typename Executor>
+inline bool DeserializeParallel(const CompactBinaryListView& view,
+                                std::vector<T, A>& var,
+                                Executor&& executor,
+                                uint32_t grain = 1024)
+{
+    static_assert(!std::is_same<T, bool>::value,
+        "Elements of std::vector<bool> can't be deserialized concurrently.");
+
+    if (view.GetElementType() != get_type_id<T>::value)
+        return false;
+
+    const uint32_t size = view.size();
+
+    resize_list(var, size);
+
+    if (size == 0)
+        return true;
+
+    grain = (std::max)(grain, 1u);
+
+    struct
+    {
+        std::mutex lock;
+        std::condition_variable done;
+        uint32_t pending;
+        std::exception_ptr error;
+    } state;
+
+    state.pending = (size - 1) / grain + 1;
+
+    auto complete = [&state](uint32_t count, std::exception_ptr error)
+    {
+        std::lock_guard<std::mutex> lock(state.lock);
+
+        if (error && !state.error)
+            state.error = error;
+
+        if ((state.pending -= count) == 0)
+            state.done.notify_all();
+    };
+
+    uint32_t index = 0;
+
+    try
+    {
+        for (; index < size; index += grain)
+        {
+            const uint32_t count = (std::min)(grain, size - index);
+            T* first = &var[index];
+
+            executor(std::function<void()>([&view, &complete, index, count, first]
+            {
+                std::exception_ptr error;
+
+                try
+                {
+                    view.GetElements(index, count, first);
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+
+                complete(1, error);
+            }));
+        }
+    }
+    catch (...)
+    {
+        // Ranges which were not scheduled won't complete on their own
+        complete((size - index - 1) / grain + 1, std::current_exception());
+    }
+
+    std::unique_lock<std::mutex> lock(state.lock);
+    state.done.wait(lock, [&state] { return state.pending == 0; });
+
+    if (state.error)
+        std::rethrow_exception(state.error);
+
+    return true;
+}
+
+} // namespace bond
@@ -48,6 +48,8 @@
 #include <boost/noncopyable.hpp>
 
 #include <algorithm>
+#include <cstring>
+#include <vector>
 
 namespace bond
 {
@@ -143,37 +145,47 @@ private:
 };
 
 
-// Adapter from Bond output stream to rapidjson write-only stream
-template <typename Buffer>
-class RapidJsonOutputStream
+inline bool IsJsonEscaped(char c)
 {
-public:
-    explicit RapidJsonOutputStream(Buffer& output)
-        : _output(output)
-    {
-    }
+    return static_cast<uint8_t>(c) < 0x20 || c == '\"' || c == '\\';
+}
 
-    typedef char Ch;
 
-    // not implemented for write-only stream
-    char Peek() { BOOST_ASSERT(false); return 0; }
-    size_t Tell() const { BOOST_ASSERT(false); return 0; }
-    char Take() { BOOST_ASSERT(false); return 0; }
-    size_t PutEnd(char* begin) { BOOST_ASSERT(false); return 0; }
-    char* PutBegin() { BOOST_ASSERT(false); return 0; }
+// Returns the first character in the range which must be escaped in a JSON
+// string, i.e. a control character, quote or backslash, or the end of the
+// range. The characters are tested 8 at a time; UTF-8 sequences are never
+// escaped.
+inline const char* FindJsonEscaped(const char* begin, const char* end)
+{
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
 
-    void Put(char c)
+    for (; end - begin >= 8; begin += 8)
     {
-        _output.Write(c);
+        uint64_t word;
+        std::memcpy(&word, begin, sizeof(word));
+
+        const uint64_t quote = word ^ (ones * '\"');
+        const uint64_t backslash = word ^ (ones * '\\');
+
+        // High bit is set in bytes less than 0x20, equal to '"' or to '\'
+        // (and possibly in bytes following them, which doesn't matter as the
+        // word is then scanned one character at a time).
+        if ((((word - ones * 0x20) & ~word)
+           | ((quote - ones) & ~quote)
+           | ((backslash - ones) & ~backslash)) & highs)
+        {
+            break;
+        }
     }
 
-    void Flush()
+    while (begin != end && !IsJsonEscaped(*begin))
     {
+        ++begin;
     }
 
-private:
-    Buffer& _output;
-};
+    return begin;
+}
 
 
 // Specialization to allow using string as input buffer for simple JSON reader
@@ -244,6 +256,156 @@ private:
 };
 
 
+// Hash index of the members of a JSON object by name and by id, used to find
+// fields in objects with many members without comparing every member name.
+class JsonMemberIndex
+{
+public:
+    JsonMemberIndex()
+        : _object(nullptr),
+          _mask()
+    {}
+
+    // The linear search is faster for small objects
+    static bool IsWorthwhile(const rapidjson::Value& object)
+    {
+        return object.IsObject() && object.MemberCount() > 8;
+    }
+
+    bool IsBuiltFor(const rapidjson::Value& object) const
+    {
+        return _object == &object;
+    }
+
+    // Forgets the object, which must be done when the memory it is in is
+    // reused for another value, since that may be at the same address.
+    void Clear()
+    {
+        _object = nullptr;
+    }
+
+    void Build(const rapidjson::Value& object)
+    {
+        BOOST_ASSERT(object.IsObject());
+
+        uint32_t size = 16;
+        while (size < object.MemberCount() * 2)
+        {
+            size *= 2;
+        }
+
+        _object = &object;
+        _mask = size - 1;
+        _names.assign(size, Slot());
+        _ids.assign(size, Slot());
+
+        uint32_t member = 0;
+
+        for (rapidjson::Value::ConstMemberIterator it = object.MemberBegin(), end = object.MemberEnd(); it != end; ++it)
+        {
+            const char* name = it->name.GetString();
+
+            // Only the first member with a given name or id is indexed
+            Insert(_names, Hash(name), ++member, [&](const Slot& slot)
+            {
+                return std::strcmp(MemberName(slot), name) == 0;
+            });
+
+            uint16_t id;
+            if (try_lexical_convert(name, id))
+            {
+                Insert(_ids, id, member, [](const Slot&) { return true; });
+            }
+        }
+    }
+
+    // Returns the first member whose name or string representation of id
+    // matches, or MemberEnd() if there is none.
+    rapidjson::Value::ConstMemberIterator Find(const char* name, uint16_t id) const
+    {
+        BOOST_ASSERT(_object);
+
+        const uint32_t byName = Lookup(_names, Hash(name), [&](const Slot& slot)
+        {
+            return std::strcmp(MemberName(slot), name) == 0;
+        });
+
+        const uint32_t byId = Lookup(_ids, id, [](const Slot&) { return true; });
+
+        // Slots store 1-based member positions, 0 meaning not found
+        const uint32_t member = (byName && byId) ? (std::min)(byName, byId) : (byName | byId);
+
+        return member ? _object->MemberBegin() + (member - 1) : _object->MemberEnd();
+    }
+
+private:
+    struct Slot
+    {
+        Slot()
+            : key(),
+              member()
+        {}
+
+        uint32_t key;
+        uint32_t member;
+    };
+
+    static uint32_t Hash(const char* str)
+    {
+        // FNV-1a
+        uint32_t hash = 2166136261u;
+
+        for (; *str; ++str)
+        {
+            hash = (hash ^ static_cast<uint8_t>(*str)) * 16777619u;
+        }
+
+        return hash;
+    }
+
+    const char* MemberName(const Slot& slot) const
+    {
+        return (_object->MemberBegin() + (slot.member - 1))->name.GetString();
+    }
+
+    template <typename Equal>
+    void Insert(std::vector<Slot>& table, uint32_t key, uint32_t member, const Equal& equal)
+    {
+        uint32_t i = key & _mask;
+
+        for (; table[i].member; i = (i + 1) & _mask)
+        {
+            if (table[i].key == key && equal(table[i]))
+            {
+                return;
+            }
+        }
+
+        table[i].key = key;
+        table[i].member = member;
+    }
+
+    template <typename Equal>
+    uint32_t Lookup(const std::vector<Slot>& table, uint32_t key, const Equal& equal) const
+    {
+        for (uint32_t i = key & _mask; table[i].member; i = (i + 1) & _mask)
+        {
+            if (table[i].key == key && equal(table[i]))
+            {
+                return table[i].member;
+            }
+        }
+
+        return 0;
+    }
+
+    const rapidjson::Value* _object;
+    uint32_t _mask;
+    std::vector<Slot> _names;
+    std::vector<Slot> _ids;
+};
+
+
 // bool
 inline void Read(const rapidjson::Value& value, bool& var)
 {
@@ -72,6 +72,49 @@ void GenericWriteVariableUnsigned(Buffer& output, T value)
 }
 
 
+template <typename Buffer, typename T, typename Enable = void> struct
+implements_varint_array_write
+    : std::false_type {};
+
+
+template <typename Buffer, typename T> struct
+implements_varint_array_write<Buffer, T,
+#ifdef BOND_NO_SFINAE_EXPR
+    typename boost::enable_if<check_method<void (Buffer::*)(const T*, uint32_t), &Buffer::WriteVariableUnsigned> >::type>
+#else
+    detail::mpl::void_t<decltype(std::declval<Buffer>().WriteVariableUnsigned(
+        std::declval<const T*>(), std::declval<uint32_t>()))>>
+#endif
+    : std::true_type {};
+
+
+// Write an array of variable encoded unsigned integers
+template<typename Buffer, typename T>
+inline
+typename boost::enable_if<implements_varint_array_write<Buffer, T> >::type
+WriteVariableUnsigned(Buffer& output, const T* values, uint32_t size)
+{
+    BOOST_STATIC_ASSERT(std::is_unsigned<T>::value);
+
+    // Use Buffer's implementation of bulk WriteVariableUnsigned
+    output.WriteVariableUnsigned(values, size);
+}
+
+
+template<typename Buffer, typename T>
+inline
+typename boost::disable_if<implements_varint_array_write<Buffer, T> >::type
+WriteVariableUnsigned(Buffer& output, const T* values, uint32_t size)
+{
+    BOOST_STATIC_ASSERT(std::is_unsigned<T>::value);
+
+    for (const T* const end = values + size; values != end; ++values)
+    {
+        WriteVariableUnsigned(output, *values);
+    }
+}
+
+
 template <typename Buffer, typename T, typename Enable = void> struct
 implements_varint_read
     : std::false_type {};
@@ -131,6 +174,88 @@ ReadVariableUnsigned(Buffer& input, T& value)
 }
 
 
+template <typename Buffer, typename T, typename Enable = void> struct
+implements_varint_array_read
+    : std::false_type {};
+
+
+template <typename Buffer, typename T> struct
+implements_varint_array_read<Buffer, T,
+#ifdef BOND_NO_SFINAE_EXPR
+    typename boost::enable_if<check_method<void (Buffer::*)(T*, uint32_t), &Buffer::ReadVariableUnsigned> >::type>
+#else
+    detail::mpl::void_t<decltype(std::declval<Buffer>().ReadVariableUnsigned(
+        std::declval<T*>(), std::declval<uint32_t>()))>>
+#endif
+    : std::true_type {};
+
+
+// Read an array of variable encoded unsigned integers
+template<typename Buffer, typename T>
+inline
+typename boost::enable_if<implements_varint_array_read<Buffer, T> >::type
+ReadVariableUnsigned(Buffer& input, T* values, uint32_t size)
+{
+    BOOST_STATIC_ASSERT(std::is_unsigned<T>::value);
+
+    // Use Buffer's implementation of bulk ReadVariableUnsigned
+    input.ReadVariableUnsigned(values, size);
+}
+
+
+template<typename Buffer, typename T>
+inline
+typename boost::disable_if<implements_varint_array_read<Buffer, T> >::type
+ReadVariableUnsigned(Buffer& input, T* values, uint32_t size)
+{
+    BOOST_STATIC_ASSERT(std::is_unsigned<T>::value);
+
+    for (T* const end = values + size; values != end; ++values)
+    {
+        ReadVariableUnsigned(input, *values);
+    }
+}
+
+
+template <typename Buffer, typename Enable = void> struct
+implements_varint_skip
+    : std::false_type {};
+
+
+template <typename Buffer> struct
+implements_varint_skip<Buffer,
+#ifdef BOND_NO_SFINAE_EXPR
+    typename boost::enable_if<check_method<void (Buffer::*)(uint32_t), &Buffer::SkipVariableUnsigned> >::type>
+#else
+    detail::mpl::void_t<decltype(std::declval<Buffer>().SkipVariableUnsigned(std::declval<uint32_t>()))>>
+#endif
+    : std::true_type {};
+
+
+// Skip an array of variable encoded unsigned integers
+template<typename Buffer>
+inline
+typename boost::enable_if<implements_varint_skip<Buffer> >::type
+SkipVariableUnsigned(Buffer& input, uint32_t size)
+{
+    // Use Buffer's implementation of SkipVariableUnsigned, which doesn't
+    // decode the values
+    input.SkipVariableUnsigned(size);
+}
+
+
+template<typename Buffer>
+inline
+typename boost::disable_if<implements_varint_skip<Buffer> >::type
+SkipVariableUnsigned(Buffer& input, uint32_t size)
+{
+    for (uint64_t value; size != 0; --size)
+    {
+        ReadVariableUnsigned(input, value);
+    }
+}
+
+
 // ZigZag encoding
 template<typename T>
 inline
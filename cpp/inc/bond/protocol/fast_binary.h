@@ -172,6 +172,15 @@ public:
     }
 
 
+    // Read array of primitive values
+    template <typename T>
+    typename boost::enable_if<std::is_arithmetic<T> >::type
+    Read(T* values, uint32_t size)
+    {
+        _input.Read(values, detail::checked_multiply(size, static_cast<uint8_t>(sizeof(T))));
+    }
+
+
     // Read for strings
     template <typename T>
     typename boost::enable_if<is_string_type<T> >::type
@@ -549,6 +558,14 @@ public:
         _output.Write(value);
     }
 
+    // Write array of primitive values
+    template <typename T>
+    typename boost::enable_if<std::is_arithmetic<T> >::type
+    Write(const T* values, uint32_t size)
+    {
+        _output.Write(values, detail::checked_multiply(size, static_cast<uint8_t>(sizeof(T))));
+    }
+
     // Write for strings
     template <typename T>
     typename boost::enable_if<is_string_type<T> >::type
@@ -0,0 +1,428 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "compact_binary.h"
+
+#include <bond/core/blob.h>
+#include <bond/core/bond.h>
+#include <bond/core/exception.h>
+#include <bond/stream/input_buffer.h>
+#include <bond/stream/output_buffer.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include <cstring>
+#include <vector>
+
+namespace bond
+{
+
+// Layout of a record stream; all integers are little-endian:
+//
+//   header:  uint32 magic, uint16 protocol, uint16 version
+//   block:   uint64 sync, uint32 record count, uint32 size, uint32 checksum,
+//            records: uint32 length, payload of the record
+//   ...
+//   index:   uint64 offset of each block
+//   footer:  uint64 offset of the index, uint32 block count, uint32 magic
+//
+// The checksum of the block header is computed from the record count and the
+// size, so that a sync marker occurring in a payload is unlikely to be taken
+// for the beginning of a block.
+namespace record_stream
+{
+
+BOND_CONSTEXPR_OR_CONST uint32_t magic = 0x53524442; // "BDRS"
+BOND_CONSTEXPR_OR_CONST uint32_t index_magic = 0x58444952; // "RIDX"
+BOND_CONSTEXPR_OR_CONST uint64_t sync = 0x268e4be5d13c9a7fULL;
+
+BOND_CONSTEXPR_OR_CONST uint32_t header_size = 8;
+BOND_CONSTEXPR_OR_CONST uint32_t block_header_size = 20;
+BOND_CONSTEXPR_OR_CONST uint32_t footer_size = 16;
+
+inline uint32_t BlockChecksum(uint32_t count, uint32_t size)
+{
+    // FNV-1a
+    const uint32_t values[] = { count, size };
+    uint32_t hash = 2166136261u;
+
+    for (uint32_t value : values)
+    {
+        for (int i = 0; i < 4; ++i, value >>= 8)
+        {
+            hash = (hash ^ (value & 0xff)) * 16777619u;
+        }
+    }
+
+    return hash;
+}
+
+
+// Reader constructed for the specified protocol version. Readers of protocols
+// with a single version don't take the version argument.
+template <typename Reader>
+typename boost::enable_if<protocol_has_multiple_versions<Reader>, Reader>::type
+inline MakeReader(const blob& data, uint16_t version)
+{
+    return Reader(InputBuffer(data), version);
+}
+
+
+template <typename Reader>
+typename boost::disable_if<protocol_has_multiple_versions<Reader>, Reader>::type
+inline MakeReader(const blob& data, uint16_t /*version*/)
+{
+    return Reader(InputBuffer(data));
+}
+
+} // namespace record_stream
+
+
+/// @brief Writer of a stream of records split into blocks
+///
+/// Each record is serialized using the protocol of the Writer and prefixed
+/// with its length. Records are collected into blocks of approximately the
+/// specified size, each starting with a header containing a sync marker, and
+/// Close appends an index of the blocks. Blocks can be located using the
+/// index and decoded independently of each other, e.g. in parallel, and a
+/// reader can resynchronize on the next sync marker after a corrupt region.
+///
+/// Records are written to the output stream one block at a time, and the
+/// current block is written when the writer is destroyed. A stream which
+/// wasn't closed has no index but can still be read by scanning for the sync
+/// markers.
+template <typename Buffer, typename Writer = CompactBinaryWriter<OutputBuffer> >
+class RecordStreamWriter
+    : boost::noncopyable
+{
+    BOOST_STATIC_ASSERT((std::is_same<typename Writer::Buffer, OutputBuffer>::value));
+
+public:
+    /// @brief Construct from output buffer/stream
+    /// @param output reference to output buffer/stream
+    /// @param blockSize size of the records after which a block is ended
+    /// @param version version of the protocol of the records
+    explicit RecordStreamWriter(Buffer& output,
+                                uint32_t blockSize = 1024 * 1024,
+                                uint16_t version = default_version<typename Writer::Reader>::value)
+        : _output(output),
+          _blockSize(blockSize),
+          _writer(_block, version),
+          _count(0),
+          _position(record_stream::header_size)
+    {
+        _output.Write(record_stream::magic);
+        _output.Write(static_cast<uint16_t>(Writer::Reader::magic));
+        _output.Write(version);
+    }
+
+    /// @brief Write the records of the current block, if any
+    ///
+    /// Errors are ignored and the index isn't written, so Close should be
+    /// called before the writer is destroyed.
+    ~RecordStreamWriter()
+    {
+        try
+        {
+            Flush();
+        }
+        catch (...)
+        {}
+    }
+
+    /// @brief Serialize a record
+    ///
+    /// The record can be an instance of a struct or a bonded<T>.
+    template <typename T>
+    void Write(const T& record)
+    {
+        char* length = _block.Reserve(sizeof(uint32_t));
+        const uint32_t begin = _block.GetPosition();
+
+        Serialize(record, static_cast<Writer&>(_writer));
+
+        const uint32_t size = _block.GetPosition() - begin;
+        std::memcpy(length, &size, sizeof(size));
+
+        ++_count;
+
+        if (_block.GetPosition() >= _blockSize)
+        {
+            Flush();
+        }
+    }
+
+    /// @brief End the current block and write it to the output stream
+    void Flush()
+    {
+        if (_count == 0)
+        {
+            return;
+        }
+
+        std::vector<blob> buffers;
+        _block.GetBuffers(buffers);
+
+        const uint32_t size = _block.GetPosition();
+
+        _output.Write(record_stream::sync);
+        _output.Write(_count);
+        _output.Write(size);
+        _output.Write(record_stream::BlockChecksum(_count, size));
+
+        for (const blob& buffer : buffers)
+        {
+            _output.Write(buffer.content(), buffer.length());
+        }
+
+        _index.push_back(_position);
+        _position += record_stream::block_header_size + size;
+
+        // The block has been copied to the output stream, so its memory can
+        // be reused for the next one
+        _block.Clear();
+        _count = 0;
+    }
+
+    /// @brief Write the last block and the index of the blocks
+    ///
+    /// No records can be written after the stream is closed.
+    void Close()
+    {
+        Flush();
+
+        for (uint64_t offset : _index)
+        {
+            _output.Write(offset);
+        }
+
+        _output.Write(_position);
+        _output.Write(static_cast<uint32_t>(_index.size()));
+        _output.Write(record_stream::index_magic);
+    }
+
+private:
+    Buffer& _output;
+    const uint32_t _blockSize;
+    OutputBuffer _block;
+    detail::VersionedWriter<Writer> _writer;
+    uint32_t _count;
+    uint64_t _position;
+    std::vector<uint64_t> _index;
+};
+
+
+/// @brief Reader of a stream of records written by RecordStreamWriter
+///
+/// The blocks are located when the reader is constructed, using the index at
+/// the end of the stream if it is valid, or otherwise by scanning the stream
+/// for the sync markers, skipping data which isn't a valid block. The records
+/// of each block are decoded on demand; since the reader isn't modified by
+/// decoding, the blocks can be decoded concurrently by multiple threads.
+template <typename Reader = CompactBinaryReader<InputBuffer> >
+class RecordStreamReader
+{
+    BOOST_STATIC_ASSERT((std::is_same<typename Reader::Buffer, InputBuffer>::value));
+
+public:
+    /// @brief Construct from a record stream
+    explicit RecordStreamReader(const blob& data)
+        : _data(data),
+          _indexed(false)
+    {
+        if (_data.length() < record_stream::header_size
+            || Load<uint32_t>(0) != record_stream::magic)
+        {
+            BOND_THROW(StreamException, "Invalid record stream header");
+        }
+
+        const uint16_t protocol = Load<uint16_t>(4);
+        _version = Load<uint16_t>(6);
+
+        if (protocol != Reader::magic)
+        {
+            BOND_THROW(StreamException,
+                "Record stream protocol " << protocol << " doesn't match the reader protocol " << Reader::magic);
+        }
+
+        _indexed = ReadIndex();
+
+        if (!_indexed)
+        {
+            _blocks.clear();
+            Scan(record_stream::header_size, _data.length());
+        }
+    }
+
+    /// @brief Check if the blocks were located using the index of the stream
+    bool IsIndexed() const
+    {
+        return _indexed;
+    }
+
+    /// @brief Number of blocks
+    size_t GetBlockCount() const
+    {
+        return _blocks.size();
+    }
+
+    /// @brief Number of records in the specified block
+    uint32_t GetRecordCount(size_t block) const
+    {
+        return _blocks[block].count;
+    }
+
+    /// @brief Call the function with bonded<T, Reader> of each record of the
+    /// specified block
+    ///
+    /// Throws StreamException if the records don't match the framing of the
+    /// block; the following blocks can still be read.
+    template <typename T, typename Function>
+    void ForEachRecord(size_t block, const Function& function) const
+    {
+        const Block& b = _blocks[block];
+        InputBuffer input(_data.range(b.offset, b.size));
+
+        for (uint32_t i = 0; i < b.count; ++i)
+        {
+            uint32_t length;
+            blob record;
+
+            input.Read(length);
+            input.Read(record, length);
+
+            function(bonded<T, Reader>(record_stream::MakeReader<Reader>(record, _version)));
+        }
+
+        if (!input.IsEof())
+        {
+            BOND_THROW(StreamException,
+                "Records of block " << block << " don't match the block size: " << b.size);
+        }
+    }
+
+    /// @brief Deserialize the records of the specified block
+    template <typename T>
+    void ReadBlock(size_t block, std::vector<T>& records) const
+    {
+        records.reserve(records.size() + GetRecordCount(block));
+
+        ForEachRecord<T>(block, [&records](const bonded<T, Reader>& record)
+        {
+            records.emplace_back();
+            record.Deserialize(records.back());
+        });
+    }
+
+private:
+    struct Block
+    {
+        uint32_t offset;
+        uint32_t size;
+        uint32_t count;
+    };
+
+    template <typename T>
+    T Load(uint64_t offset) const
+    {
+        T value;
+        std::memcpy(&value, _data.content() + offset, sizeof(T));
+        return value;
+    }
+
+    // Adds the block starting at the offset if it has a valid header and
+    // ends before the end.
+    bool AddBlock(uint64_t offset, uint64_t end)
+    {
+        if (offset + record_stream::block_header_size > end
+            || Load<uint64_t>(offset) != record_stream::sync)
+        {
+            return false;
+        }
+
+        Block block;
+        block.count = Load<uint32_t>(offset + 8);
+        block.size = Load<uint32_t>(offset + 12);
+        block.offset = static_cast<uint32_t>(offset + record_stream::block_header_size);
+
+        if (Load<uint32_t>(offset + 16) != record_stream::BlockChecksum(block.count, block.size)
+            || block.offset + static_cast<uint64_t>(block.size) > end
+            || block.count > block.size / sizeof(uint32_t))
+        {
+            return false;
+        }
+
+        _blocks.push_back(block);
+        return true;
+    }
+
+    bool ReadIndex()
+    {
+        const uint64_t length = _data.length();
+
+        if (length < record_stream::header_size + record_stream::footer_size
+            || Load<uint32_t>(length - 4) != record_stream::index_magic)
+        {
+            return false;
+        }
+
+        const uint64_t index = Load<uint64_t>(length - record_stream::footer_size);
+        const uint32_t count = Load<uint32_t>(length - 8);
+
+        if (index < record_stream::header_size
+            || index > length - record_stream::footer_size
+            || length - record_stream::footer_size - index != count * static_cast<uint64_t>(sizeof(uint64_t)))
+        {
+            return false;
+        }
+
+        uint64_t end = record_stream::header_size;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const uint64_t offset = Load<uint64_t>(index + i * sizeof(uint64_t));
+
+            if (offset < end || !AddBlock(offset, index))
+            {
+                return false;
+            }
+
+            end = _blocks.back().offset + static_cast<uint64_t>(_blocks.back().size);
+        }
+
+        return true;
+    }
+
+    void Scan(uint64_t offset, uint64_t end)
+    {
+        const char* const data = _data.content();
+
+        while (offset + record_stream::block_header_size <= end)
+        {
+            if (AddBlock(offset, end))
+            {
+                offset = _blocks.back().offset + static_cast<uint64_t>(_blocks.back().size);
+                continue;
+            }
+
+            // Resynchronize on the next sync marker
+            const void* next = std::memchr(data + offset + 1, static_cast<int>(record_stream::sync & 0xff),
+                static_cast<size_t>(end - offset - 1));
+
+            offset = next ? static_cast<uint64_t>(static_cast<const char*>(next) - data) : end;
+        }
+    }
+
+    blob _data;
+    uint16_t _version;
+    bool _indexed;
+    std::vector<Block> _blocks;
+};
+
+} // namespace bond
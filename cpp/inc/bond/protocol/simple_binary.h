@@ -8,6 +8,7 @@
 #include "encoding.h"
 
 #include <bond/core/bond_version.h>
+#include <bond/core/detail/checked.h>
 #include <bond/core/traits.h>
 
 #include <boost/call_traits.hpp>
@@ -157,6 +158,15 @@ public:
     }
 
 
+    // Read array of basic values
+    template <typename T>
+    typename boost::enable_if<std::is_arithmetic<T> >::type
+    Read(T* values, uint32_t size)
+    {
+        _input.Read(values, detail::checked_multiply(size, static_cast<uint8_t>(sizeof(T))));
+    }
+
+
     // Read for strings
     template <typename T>
     typename boost::enable_if<is_string_type<T> >::type
@@ -356,6 +366,14 @@ public:
         _output.Write(value);
     }
 
+    // Write array of basic values
+    template <typename T>
+    typename boost::enable_if<std::is_arithmetic<T> >::type
+    Write(const T* values, uint32_t size)
+    {
+        _output.Write(values, detail::checked_multiply(size, static_cast<uint8_t>(sizeof(T))));
+    }
+
     // Write for strings
     template <typename T>
     typename boost::enable_if<is_string_type<T> >::type
@@ -39,6 +39,7 @@ public:
     SimpleJsonReader(const Buffer& input)
         : _value(nullptr),
           _document(boost::make_shared<rapidjson::Document>()),
+          _arrayElement(false),
           _streamHolder(input)
     { }
 
@@ -49,6 +50,7 @@ public:
     SimpleJsonReader(SimpleJsonReader& parent, const Field& value)
         : _value(&value),
           _document(parent._document),
+          _arrayElement(false),
           _streamHolder(parent)
     {
         // Must have an already-parsed parent
@@ -65,6 +67,22 @@ public:
         // Don't need to reparse for nested fields
         if (!_value || _value == _document.get())
         {
+            if (_value)
+            {
+                // Reading the next value from the stream. Release the memory
+                // of the previous one, unless it is still referenced, e.g. by
+                // a bonded<T> deserialized from it.
+                if (_document.use_count() == 1)
+                {
+                    _document->SetNull();
+                    _document->GetAllocator().Clear();
+                }
+                else
+                {
+                    _document = boost::make_shared<rapidjson::Document>();
+                }
+            }
+
             const unsigned parseFlags = rapidjson::kParseIterativeFlag | rapidjson::kParseStopWhenDoneFlag;
 
             _document->ParseStream<parseFlags>(_streamHolder.Get());
@@ -73,6 +91,10 @@ public:
             // thrown, as we define RAPIDJSON_PARSE_ERROR
             BOOST_ASSERT(!_document->HasParseError());
             _value = _document.get();
+
+            // The root of the new value is at the same address as the
+            // previous one, so the index of its members must be rebuilt.
+            _index.Clear();
         }
     }
 
@@ -88,6 +110,20 @@ public:
 
     const Field* FindField(uint16_t id, const Metadata& metadata, BondDataType type, bool is_enum);
 
+    /// @brief Start reading a JSON array one element at a time.
+    ///
+    /// The array must be the next value in the input. After each call to
+    /// NextArrayElement that returns true, deserializing using this reader
+    /// by reference (e.g. via bonded<T, SimpleJsonReader&>) reads the next
+    /// element of the array. Only the current element is parsed into memory,
+    /// so arrays of records of any size can be read in bounded memory.
+    void BeginArray();
+
+    /// @brief Advance to the next element of the array started by BeginArray.
+    ///
+    /// @return false if the end of the array has been reached.
+    bool NextArrayElement();
+
 
     template <typename T>
     void Read(T& var)
@@ -188,6 +224,12 @@ private:
     const rapidjson::Value* _value;
     boost::shared_ptr<rapidjson::Document> _document;
 
+    // Whether an element of an array read with NextArrayElement was started
+    bool _arrayElement;
+
+    // Built on the first field lookup in an object with many members
+    detail::JsonMemberIndex _index;
+
     /// @brief Holds either an input stream XOR a pointer to some parent
     /// StreamHolder.
     class StreamHolder
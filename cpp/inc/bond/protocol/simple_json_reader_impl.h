@@ -21,6 +21,30 @@ SimpleJsonReader<BufferT>::FindField(uint16_t id, const Metadata& metadata, Bond
         const char* name = detail::FieldName(metadata).c_str();
         detail::JsonTypeMatching jsonType(type, type, is_enum);
 
+        if (detail::JsonMemberIndex::IsWorthwhile(*GetValue()))
+        {
+            if (!_index.IsBuiltFor(*GetValue()))
+            {
+                _index.Build(*GetValue());
+            }
+
+            // The index finds the first member matching by name or id;
+            // if its value has a different type keep looking after it.
+            it = _index.Find(name, id);
+
+            if (it == MemberEnd())
+            {
+                return NULL;
+            }
+
+            if (jsonType.TypeMatch(it->value))
+            {
+                return &it->value;
+            }
+
+            ++it;
+        }
+
         // Match member by type of value and either metadata name, or string reprentation of id
         for (rapidjson::Value::ConstMemberIterator end = MemberEnd(); it != end; ++it)
         {
@@ -45,6 +69,52 @@ SimpleJsonReader<BufferT>::FindField(uint16_t id, const Metadata& metadata, Bond
     return NULL;
 }
 
+template <typename BufferT>
+inline void SimpleJsonReader<BufferT>::BeginArray()
+{
+    auto& stream = _streamHolder.Get();
+
+    rapidjson::SkipWhitespace(stream);
+
+    if (stream.Peek() != '[')
+    {
+        RapidJsonException("Array expected", stream.Tell());
+    }
+
+    stream.Take();
+    _arrayElement = false;
+}
+
+
+template <typename BufferT>
+inline bool SimpleJsonReader<BufferT>::NextArrayElement()
+{
+    auto& stream = _streamHolder.Get();
+
+    rapidjson::SkipWhitespace(stream);
+
+    if (stream.Peek() == ']')
+    {
+        stream.Take();
+        _arrayElement = false;
+        return false;
+    }
+
+    if (_arrayElement)
+    {
+        if (stream.Peek() != ',')
+        {
+            RapidJsonException("Missing a comma or ']' after an array element", stream.Tell());
+        }
+
+        stream.Take();
+    }
+
+    _arrayElement = true;
+    return true;
+}
+
+
 // deserialize std::vector<bool>
 template <typename Protocols, typename A, typename T, typename Buffer>
 inline void DeserializeContainer(std::vector<bool, A>& var, const T& /*element*/, SimpleJsonReader<Buffer>& reader)
@@ -19,10 +19,13 @@ class SimpleJsonReader;
 
 
 /// @brief Writer for Simple JSON
+///
+/// Strings are copied to the output buffer in runs of characters which don't
+/// need escaping, and numbers are formatted in a local buffer, so that the
+/// output buffer is written once per value rather than once per character.
 template <typename BufferT>
 class SimpleJsonWriter
-    : protected rapidjson::Writer<detail::RapidJsonOutputStream<BufferT> >,
-      boost::noncopyable
+    : boost::noncopyable
 {
 public:
     typedef BufferT                     Buffer;
@@ -34,9 +37,7 @@ public:
     /// @param indent number of spaces of indentation, default 4
     /// @param all_fields if false, optional fields may be omitted, default true
     SimpleJsonWriter(Buffer& output, bool pretty = false, int indent = 4, bool all_fields = true)
-        : rapidjson::Writer<detail::RapidJsonOutputStream<BufferT> >(_stream),
-          _stream(output),
-          _output(output),
+        : _output(output),
           _count(0),
           _level(0),
           _indent((std::min)(indent, 8)),
@@ -79,9 +80,14 @@ public:
     
     void WriteName(uint16_t id)
     {
-        _output.Write('\"');
-        this->WriteUint(id);
-        _output.Write("\": ", _pretty ? 3 : 2);
+        char buffer[16] = "\"";
+        char* end = rapidjson::internal::u32toa(id, buffer + 1);
+
+        *end++ = '\"';
+        *end++ = ':';
+        *end++ = ' ';
+
+        WriteNumber(buffer, _pretty ? end : end - 1);
     }
     
     void Write(bool value)
@@ -103,26 +109,34 @@ public:
     typename boost::enable_if<is_signed_int<T> >::type
     Write(T value)
     {
-        this->WriteInt64(value);
+        char buffer[24];
+        WriteNumber(buffer, rapidjson::internal::i64toa(value, buffer));
     }
 
     template <typename T>
     typename boost::enable_if<std::is_unsigned<T> >::type
     Write(T value)
     {
-        this->WriteUint64(value);
+        char buffer[24];
+        WriteNumber(buffer, rapidjson::internal::u64toa(value, buffer));
     }
 
     void Write(double value)
     {
-        this->WriteDouble(value);
+        // NaN and infinity can't be represented in JSON and are not written
+        if (rapidjson::internal::Double(value).IsNanOrInf())
+            return;
+
+        char buffer[32];
+        WriteNumber(buffer, rapidjson::internal::dtoa(value, buffer));
     }
 
     template <typename T>
     typename boost::enable_if<std::is_enum<T> >::type
     Write(const T& value)
     {
-        this->WriteInt(static_cast<int>(value));
+        char buffer[16];
+        WriteNumber(buffer, rapidjson::internal::i32toa(static_cast<int>(value), buffer));
     }
 
     template <typename T>
@@ -147,22 +161,51 @@ public:
     }
     
 private:
-    using rapidjson::Writer<detail::RapidJsonOutputStream<BufferT> >::WriteString;
-
     template <typename T>
     typename boost::enable_if<is_string<T> >::type
     WriteString(const T& value)
     {
-        WriteString(string_data(value), string_length(value));
+        const char* begin = string_data(value);
+        const char* const end = begin + string_length(value);
+
+        _output.Write('\"');
+
+        for (;;)
+        {
+            const char* const escaped = detail::FindJsonEscaped(begin, end);
+
+            if (escaped != begin)
+                _output.Write(begin, static_cast<uint32_t>(escaped - begin));
+
+            if (escaped == end)
+                break;
+
+            WriteEscaped(*escaped);
+            begin = escaped + 1;
+        }
+
+        _output.Write('\"');
     }
 
     template <typename T>
     typename boost::enable_if<is_wstring<T> >::type
     WriteString(const T& value)
     {
-        _output.Write('\"');
-        for (const wchar_t *p = string_data(value), *end = p + string_length(value); p < end; ++p) 
+        // Escaped characters are accumulated in a local buffer which is
+        // flushed when it may not fit the next one and the closing quote.
+        char buffer[256];
+        char* out = buffer;
+
+        *out++ = '\"';
+
+        for (const wchar_t *p = string_data(value), *end = p + string_length(value); p < end; ++p)
         {
+            if (out > buffer + sizeof(buffer) - 7)
+            {
+                _output.Write(buffer, static_cast<uint32_t>(out - buffer));
+                out = buffer;
+            }
+
             wchar_t c = *p;
 
             if (c < L'\x20' || c == '"' || c == '\\' || c == '/')
@@ -177,29 +220,58 @@ private:
                 }
 
                 if (c >= L'\x20')
-                    _output.Write('\\');
+                    *out++ = '\\';
             }
-            
+
             if (c >= L'\x20' && c < L'\x80')
             {
-                _output.Write(static_cast<char>(c));
+                *out++ = static_cast<char>(c);
             }
             else
             {
-                WriteUnicode(c);
+                *out++ = '\\';
+                *out++ = 'u';
+                *out++ = detail::HexDigit(c >> 12);
+                *out++ = detail::HexDigit(c >> 8);
+                *out++ = detail::HexDigit(c >> 4);
+                *out++ = detail::HexDigit(c >> 0);
             }
         }
-        _output.Write('\"');
+
+        *out++ = '\"';
+        _output.Write(buffer, static_cast<uint32_t>(out - buffer));
+    }
+
+    // Escape sequences are the same as written by rapidjson::Writer
+    void WriteEscaped(char c)
+    {
+        char escape[6] = { '\\' };
+
+        switch (c)
+        {
+            case '\"': escape[1] = '\"'; break;
+            case '\\': escape[1] = '\\'; break;
+            case '\b': escape[1] = 'b'; break;
+            case '\f': escape[1] = 'f'; break;
+            case '\n': escape[1] = 'n'; break;
+            case '\r': escape[1] = 'r'; break;
+            case '\t': escape[1] = 't'; break;
+            default:
+                escape[1] = 'u';
+                escape[2] = '0';
+                escape[3] = '0';
+                escape[4] = "0123456789ABCDEF"[static_cast<uint8_t>(c) >> 4];
+                escape[5] = "0123456789ABCDEF"[static_cast<uint8_t>(c) & 0xf];
+                _output.Write(escape, sizeof(escape));
+                return;
+        }
+
+        _output.Write(escape, 2);
     }
 
-    void WriteUnicode(wchar_t c)
+    void WriteNumber(const char* begin, const char* end)
     {
-        char u[6] = "\\u";
-        u[2] = detail::HexDigit(c >> 12);
-        u[3] = detail::HexDigit(c >> 8);
-        u[4] = detail::HexDigit(c >> 4);
-        u[5] = detail::HexDigit(c >> 0);
-        _output.Write(u, sizeof(u));
+        _output.Write(begin, static_cast<uint32_t>(end - begin));
     }
 
     void NewLine()
@@ -215,7 +287,6 @@ private:
     template <typename Writer, typename Protocols>
     friend class Serializer;
     
-    detail::RapidJsonOutputStream<BufferT> _stream;
     Buffer& _output;
     int _count;
     int _level;
@@ -0,0 +1,156 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+#include <bond/core/exception.h>
+
+#if defined(_WIN32) || defined(WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <limits>
+
+namespace bond
+{
+
+#if defined(_WIN32) || defined(WIN32)
+
+BOND_DETAIL_HEADER_ONLY_INLINE
+MappedFile::MappedFile(const std::string& name, Access access)
+    : _data(),
+      _size()
+{
+    const DWORD flags = access == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                      : access == Access::Random ? FILE_FLAG_RANDOM_ACCESS
+                      : FILE_ATTRIBUTE_NORMAL;
+
+    const HANDLE file = ::CreateFileA(
+        name.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, flags, NULL);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        BOND_THROW(StreamException, "Error " << ::GetLastError() << " opening file " << name);
+    }
+
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+
+    if (!::GetFileSizeEx(file, &size)
+        || static_cast<uint64_t>(size.QuadPart) > (std::numeric_limits<SIZE_T>::max)())
+    {
+        ::CloseHandle(file);
+        BOND_THROW(StreamException, "Error mapping file " << name);
+    }
+
+    _size = static_cast<uint64_t>(size.QuadPart);
+
+    // Empty files can't be mapped
+    if (_size != 0)
+    {
+        mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+        if (mapping != NULL)
+        {
+            _data = static_cast<const char*>(::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+
+    // The view keeps a reference to the mapping and to the file
+    const DWORD error = ::GetLastError();
+
+    if (mapping != NULL)
+    {
+        ::CloseHandle(mapping);
+    }
+
+    ::CloseHandle(file);
+
+    if (_size != 0 && _data == NULL)
+    {
+        BOND_THROW(StreamException, "Error " << error << " mapping file " << name);
+    }
+}
+
+
+BOND_DETAIL_HEADER_ONLY_INLINE
+MappedFile::~MappedFile()
+{
+    if (_data)
+    {
+        ::UnmapViewOfFile(_data);
+    }
+}
+
+#else
+
+BOND_DETAIL_HEADER_ONLY_INLINE
+MappedFile::MappedFile(const std::string& name, Access access)
+    : _data(),
+      _size()
+{
+    const int file = ::open(name.c_str(), O_RDONLY);
+
+    if (file == -1)
+    {
+        BOND_THROW(StreamException, "Error " << errno << " opening file " << name);
+    }
+
+    struct stat status;
+
+    if (::fstat(file, &status) != 0
+        || static_cast<uint64_t>(status.st_size) > (std::numeric_limits<size_t>::max)())
+    {
+        ::close(file);
+        BOND_THROW(StreamException, "Error mapping file " << name);
+    }
+
+    _size = static_cast<uint64_t>(status.st_size);
+
+    // Empty files can't be mapped
+    void* data = _size != 0
+        ? ::mmap(NULL, static_cast<size_t>(_size), PROT_READ, MAP_PRIVATE, file, 0)
+        : NULL;
+
+    // The mapping keeps a reference to the file
+    const int error = errno;
+    ::close(file);
+
+    if (data == MAP_FAILED)
+    {
+        BOND_THROW(StreamException, "Error " << error << " mapping file " << name);
+    }
+
+    if (data != NULL && access != Access::Normal)
+    {
+        // The advice is only a hint; failure is not an error
+        ::madvise(data, static_cast<size_t>(_size),
+            access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    }
+
+    _data = static_cast<const char*>(data);
+}
+
+
+BOND_DETAIL_HEADER_ONLY_INLINE
+MappedFile::~MappedFile()
+{
+    if (_data)
+    {
+        ::munmap(const_cast<char*>(_data), static_cast<size_t>(_size));
+    }
+}
+
+#endif
+
+} // namespace bond
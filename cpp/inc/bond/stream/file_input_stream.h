@@ -0,0 +1,338 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "input_buffer.h"
+
+#include <bond/core/blob.h>
+#include <bond/core/exception.h>
+#include <bond/core/traits.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace bond
+{
+
+/// @brief Input stream reading a file in large blocks
+///
+/// The file is read one block at a time into memory from which values are
+/// decoded, instead of reading the file for every value. Reads larger than
+/// a block go directly to the destination, and skipped data that spans
+/// blocks is not read at all. Blobs and bonded<T> values read from the
+/// stream reference the memory of the current block when possible.
+///
+/// Copies of the stream share the file but keep independent positions, which
+/// lets the stream be used with bonded<T>. Copies must not be used from
+/// multiple threads concurrently.
+class FileInputStream
+{
+public:
+#if defined(_MSC_VER) && _MSC_VER < 1900
+    using range_type = blob;
+#endif
+
+    /// @brief Default constructor
+    FileInputStream()
+        : _blockSize(),
+          _pointer(),
+          _length(),
+          _offset()
+    {}
+
+    /// @brief Open the specified file for reading
+    explicit FileInputStream(const std::string& name, uint32_t blockSize = 256 * 1024)
+        : _file(boost::make_shared<File>(name)),
+          _blockSize((std::max)(blockSize, static_cast<uint32_t>(64))),
+          _pointer(),
+          _length(),
+          _offset()
+    {}
+
+
+    bool operator==(const FileInputStream& rhs) const
+    {
+        return _file == rhs._file
+            && GetPosition() == rhs.GetPosition();
+    }
+
+
+    void Read(uint8_t& value)
+    {
+        if (_length == _pointer)
+        {
+            if (IsEof())
+            {
+                EofException(sizeof(uint8_t));
+            }
+
+            Fill();
+        }
+
+        value = static_cast<uint8_t>(_block[_pointer++]);
+    }
+
+
+    template <typename T>
+    void Read(T& value)
+    {
+        BOOST_STATIC_ASSERT(std::is_arithmetic<T>::value || std::is_enum<T>::value);
+
+        if (sizeof(T) <= _length - _pointer)
+        {
+            std::memcpy(&value, _block.get() + _pointer, sizeof(T));
+            _pointer += sizeof(T);
+        }
+        else
+        {
+            Read(&value, sizeof(T));
+        }
+    }
+
+
+    void Read(void *buffer, uint32_t size)
+    {
+        if (size > GetRemaining())
+        {
+            EofException(size);
+        }
+
+        char* dest = static_cast<char*>(buffer);
+
+        while (size != 0)
+        {
+            if (_length == _pointer)
+            {
+                if (size >= _blockSize)
+                {
+                    // Large reads bypass the block
+                    Seek(GetPosition());
+                    ReadFile(dest, size);
+                    _offset += size;
+                    break;
+                }
+
+                Fill();
+            }
+
+            const uint32_t part = (std::min)(size, _length - _pointer);
+
+            std::memcpy(dest, _block.get() + _pointer, part);
+            _pointer += part;
+
+            dest += part;
+            size -= part;
+        }
+    }
+
+
+    void Read(blob& blob, uint32_t size)
+    {
+        if (size <= _length - _pointer)
+        {
+            blob.assign(_block, _pointer, size);
+            _pointer += size;
+        }
+        else
+        {
+            if (size > GetRemaining())
+            {
+                EofException(size);
+            }
+
+            boost::shared_ptr<char[]> buffer = boost::make_shared_noinit<char[]>(size);
+
+            Read(buffer.get(), size);
+            blob.assign(buffer, size);
+        }
+    }
+
+
+    void Skip(uint32_t size)
+    {
+        if (size > GetRemaining())
+        {
+            return;
+        }
+
+        if (size <= _length - _pointer)
+        {
+            _pointer += size;
+        }
+        else
+        {
+            Seek(GetPosition() + size);
+        }
+    }
+
+
+    /// @brief Check if the stream is at the end of the file.
+    bool IsEof() const
+    {
+        return GetRemaining() == 0;
+    }
+
+
+    /// @brief Returns the current offset in the file.
+    uint64_t GetPosition() const
+    {
+        return _offset + _pointer;
+    }
+
+
+    template <typename T>
+    void ReadVariableUnsigned(T& value)
+    {
+        if (_length > _pointer + sizeof(T) * 8 / 7)
+        {
+            const char* ptr = _block.get() + _pointer;
+            input_buffer::VariableUnsignedUnchecked<T, 0>::Read(ptr, value);
+            _pointer = static_cast<uint32_t>(ptr - _block.get());
+        }
+        else
+        {
+            GenericReadVariableUnsigned(*this, value);
+        }
+    }
+
+
+    template <typename T>
+    void ReadVariableUnsigned(T* values, uint32_t count)
+    {
+        T* const values_end = values + count;
+
+        while (values != values_end)
+        {
+            const char* const begin = _block.get() + _pointer;
+
+            _pointer += static_cast<uint32_t>(input_buffer::VariableUnsignedArrayUnchecked(
+                begin, _block.get() + _length, values, values_end) - begin);
+
+            // Values close to the end of a block are decoded one at a time
+            if (values != values_end)
+            {
+                ReadVariableUnsigned(*values++);
+            }
+        }
+    }
+
+protected:
+    struct File
+    {
+        explicit File(const std::string& name)
+            : stream(name, std::ios::binary),
+              size()
+        {
+            if (!stream.seekg(0, std::ios::end))
+            {
+                BOND_THROW(StreamException, "Error opening file " << name);
+            }
+
+            size = static_cast<uint64_t>(stream.tellg());
+        }
+
+        std::ifstream stream;
+        uint64_t size;
+    };
+
+    BOND_NORETURN void EofException(uint32_t size) const
+    {
+        BOND_THROW(StreamException,
+              "Read out of bounds: " << size << " bytes requested, offset: "
+              << GetPosition() << ", length: " << (_file ? _file->size : 0));
+    }
+
+    uint64_t GetRemaining() const
+    {
+        return _file ? _file->size - GetPosition() : 0;
+    }
+
+    // Moves to the specified position of the file, discarding the current block
+    void Seek(uint64_t position)
+    {
+        _offset = position;
+        _pointer = 0;
+        _length = 0;
+    }
+
+    // Reads the next block of the file, starting at the current position
+    void Fill()
+    {
+        Seek(GetPosition());
+
+        const uint32_t length = static_cast<uint32_t>((std::min)(GetRemaining(), static_cast<uint64_t>(_blockSize)));
+
+        // The block is reused unless blobs or copies of the stream reference it
+        if (!_block || _block.use_count() != 1)
+        {
+            _block = boost::make_shared_noinit<char[]>(_blockSize);
+        }
+
+        ReadFile(_block.get(), length);
+        _length = length;
+    }
+
+    // Reads data at the current offset of the stream from the file
+    void ReadFile(char* buffer, uint32_t size)
+    {
+        std::ifstream& stream = _file->stream;
+
+        stream.clear();
+
+        if (!stream.seekg(static_cast<std::streamoff>(_offset))
+            || !stream.read(buffer, size))
+        {
+            BOND_THROW(StreamException,
+                  "Error reading file: " << size << " bytes requested, offset: " << _offset);
+        }
+    }
+
+    boost::shared_ptr<File>     _file;
+    boost::shared_ptr<char[]>   _block;
+    uint32_t                    _blockSize;
+    uint32_t                    _pointer;
+    uint32_t                    _length;
+    uint64_t                    _offset;
+
+
+    friend FileInputStream GetCurrentBuffer(const FileInputStream& input)
+    {
+        return input;
+    }
+
+    friend blob GetBufferRange(const FileInputStream& begin, const FileInputStream& end);
+};
+
+
+/// @brief Returns the data between the two positions of the stream.
+inline blob GetBufferRange(const FileInputStream& begin, const FileInputStream& end)
+{
+    BOOST_ASSERT(begin._file == end._file);
+    BOOST_ASSERT(begin.GetPosition() <= end.GetPosition());
+
+    blob range;
+    FileInputStream input(begin);
+
+    input.Read(range, static_cast<uint32_t>(end.GetPosition() - begin.GetPosition()));
+
+    return range;
+}
+
+
+inline InputBuffer CreateInputBuffer(const FileInputStream& /*other*/, const blob& blob)
+{
+    return InputBuffer(blob);
+}
+
+
+BOND_DEFINE_BUFFER_MAGIC(FileInputStream, 0x4653 /*FS*/);
+
+} // namespace bond
@@ -0,0 +1,185 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "output_buffer.h"
+
+#include <bond/core/blob.h>
+#include <bond/core/exception.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <stdio.h>
+#include <stdint.h>
+
+namespace bond
+{
+
+/// @brief Buffered output stream writing to a stdio file
+///
+/// Unlike StdioOutputStream, which calls fwrite for every value, the data is
+/// collected in a large internal buffer and written to the file one block at
+/// a time. Blobs larger than the buffer are written directly from their
+/// memory, without being copied to the buffer. The internal buffer is written
+/// to the file by Flush and when the stream is destroyed.
+class FileOutputStream
+    : boost::noncopyable
+{
+public:
+    /// @brief Construct from a file opened for writing in binary mode
+    ///
+    /// The stream doesn't take ownership of the file. The buffer is at least
+    /// 64 bytes, enough to hold the encoding of any variable encoded integer.
+    explicit FileOutputStream(FILE* file, uint32_t bufferSize = 256 * 1024)
+        : _file(file),
+          _bufferSize((std::max)(bufferSize, static_cast<uint32_t>(64))),
+          _buffer(new char[_bufferSize]),
+          _size(0)
+    {}
+
+    ~FileOutputStream()
+    {
+        // Errors can't be reported from the destructor; call Flush before
+        // destroying the stream to detect them.
+        WriteFile(_buffer.get(), _size);
+    }
+
+
+    template<typename T>
+    void Write(const T& value)
+    {
+        if (sizeof(T) <= _bufferSize - _size)
+        {
+            std::memcpy(_buffer.get() + _size, &value, sizeof(T));
+            _size += sizeof(T);
+        }
+        else
+        {
+            Write(&value, sizeof(T));
+        }
+    }
+
+
+    void Write(const void* value, uint32_t size)
+    {
+        if (size > _bufferSize - _size)
+        {
+            FlushBuffer();
+
+            if (size >= _bufferSize)
+            {
+                // Large writes bypass the buffer
+                CheckedWriteFile(value, size);
+                return;
+            }
+        }
+
+        std::memcpy(_buffer.get() + _size, value, size);
+        _size += size;
+    }
+
+
+    void Write(const blob& buffer)
+    {
+        Write(buffer.data(), buffer.length());
+    }
+
+
+    template<typename T>
+    void WriteVariableUnsigned(T value)
+    {
+        if (sizeof(T) * 8 / 7 + 1 > _bufferSize - _size)
+        {
+            FlushBuffer();
+        }
+
+        _size += output_buffer::VariableUnsignedUnchecked<T, 1>::Write(_buffer.get() + _size, value);
+    }
+
+
+    template<typename T>
+    void WriteVariableUnsigned(const T* values, uint32_t count)
+    {
+        const uint32_t max_length = sizeof(T) * 8 / 7 + 1;
+
+        while (count != 0)
+        {
+            // Encode as many values as are guaranteed to fit in the buffer
+            uint32_t size = (std::min)(count, (_bufferSize - _size) / max_length);
+
+            if (size == 0)
+            {
+                FlushBuffer();
+                size = (std::min)(count, _bufferSize / max_length);
+            }
+
+            char* const ptr = _buffer.get() + _size;
+
+            _size += static_cast<uint32_t>(
+                output_buffer::VariableUnsignedArrayUnchecked(ptr, values, values + size) - ptr);
+
+            values += size;
+            count -= size;
+        }
+    }
+
+
+    /// @brief Write the content of the internal buffer and flush the file
+    void Flush()
+    {
+        FlushBuffer();
+
+        if (fflush(_file) != 0)
+        {
+            WriteException();
+        }
+    }
+
+protected:
+    void FlushBuffer()
+    {
+        const uint32_t size = _size;
+
+        _size = 0;
+        CheckedWriteFile(_buffer.get(), size);
+    }
+
+    bool WriteFile(const void* data, uint32_t size)
+    {
+        return size == 0 || fwrite(data, size, 1, _file) == 1;
+    }
+
+    void CheckedWriteFile(const void* data, uint32_t size)
+    {
+        if (!WriteFile(data, size))
+        {
+            WriteException();
+        }
+    }
+
+    BOND_NORETURN void WriteException() const
+    {
+        BOND_THROW(StreamException, "Error writing to file");
+    }
+
+    FILE*                   _file;
+    uint32_t                _bufferSize;
+    std::unique_ptr<char[]> _buffer;
+    uint32_t                _size;
+};
+
+
+// Returns a default OutputBuffer since FileOutputStream can't be used to
+// hold an intermediate serialized payload.
+inline OutputBuffer CreateOutputBuffer(const FileOutputStream& /*other*/)
+{
+    return OutputBuffer();
+}
+
+} // namespace bond
@@ -9,6 +9,7 @@
 #include <bond/core/exception.h>
 #include <bond/core/traits.h>
 #include <boost/static_assert.hpp>
+#include <cstddef>
 #include <cstring>
 
 namespace bond
@@ -85,6 +86,90 @@ struct VariableUnsignedUnchecked<uint64_t, 56>
     }
 };
 
+
+// Decodes an array of values, one 64-bit word of input at a time. Words which
+// contain 8 single-byte values, common for arrays of small integers, are
+// decoded without any per-byte branches; other values are decoded one by one.
+// The decoding stops when fewer than a word and a value are left before end,
+// the remaining values are expected to be read using the bounds checked path.
+// Returns the position after the last decoded value and advances values past
+// the decoded elements.
+template <typename T>
+inline const char* VariableUnsignedArrayUnchecked(const char* p, const char* end, T*& values, T* const values_end)
+{
+    BOOST_STATIC_ASSERT(std::is_unsigned<T>::value && sizeof(T) > 1);
+
+    // Maximum length of the encoding of a value of type T plus a word
+    const uint32_t block = (sizeof(T) * 8 + 6) / 7 + sizeof(uint64_t);
+
+    while (values != values_end && static_cast<uint32_t>(end - p) >= block)
+    {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+
+        if ((word & 0x8080808080808080ull) == 0 && values_end - values >= 8)
+        {
+            // Assumes little-endian host, like the rest of the stream.
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                values[i] = static_cast<uint8_t>(word >> (8 * i));
+            }
+
+            values += 8;
+            p += 8;
+        }
+        else
+        {
+            for (const char* const next = p + sizeof(word); p < next && values != values_end;)
+            {
+                VariableUnsignedUnchecked<T, 0>::Read(p, *values++);
+            }
+        }
+    }
+
+    return p;
+}
+
+
+// Skips variable encoded integers without decoding them, one 64-bit word of
+// input at a time, by counting the bytes which end a value. The skipping
+// stops after count values or at end. Returns the position after the last
+// skipped value and decrements count by the number of skipped values.
+inline const char* SkipVariableUnsigned(const char* p, const char* end, uint32_t& count)
+{
+    while (count != 0 && end - p >= static_cast<std::ptrdiff_t>(sizeof(uint64_t)))
+    {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+
+        // The high bit of the bytes which end a value is clear
+        const uint64_t last = ~word & 0x8080808080808080ull;
+        const uint32_t values = static_cast<uint32_t>(((last >> 7) * 0x0101010101010101ull) >> 56);
+
+        // The word can be skipped if it doesn't end in the middle of the
+        // last value to skip. Assumes little-endian host.
+        if (values < count || (values == count && (last >> 63) != 0))
+        {
+            count -= values;
+            p += sizeof(word);
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    for (; count != 0 && p != end; ++p)
+    {
+        if (static_cast<uint8_t>(*p) < 0x80)
+        {
+            --count;
+        }
+    }
+
+    return p;
+}
+
 }
 
 /// @brief Memory backed input stream
@@ -211,6 +296,13 @@ public:
     }
 
 
+    /// @brief Returns the current offset in the underlying memory buffer.
+    uint64_t GetPosition() const
+    {
+        return _pointer;
+    }
+
+
     template <typename T>
     void ReadVariableUnsigned(T& value)
     {
@@ -226,6 +318,40 @@ public:
         }
     }
 
+
+    template <typename T>
+    void ReadVariableUnsigned(T* values, uint32_t count)
+    {
+        T* const values_end = values + count;
+        const char* const begin = _blob.content();
+
+        const char* const ptr = input_buffer::VariableUnsignedArrayUnchecked(
+            begin + _pointer, begin + _blob.length(), values, values_end);
+
+        _pointer = static_cast<uint32_t>(ptr - begin);
+
+        // Values close to the end of the buffer are decoded one at a time
+        for (; values != values_end; ++values)
+        {
+            ReadVariableUnsigned(*values);
+        }
+    }
+
+
+    void SkipVariableUnsigned(uint32_t count)
+    {
+        const char* const begin = _blob.content();
+        const char* const ptr = input_buffer::SkipVariableUnsigned(
+            begin + _pointer, begin + _blob.length(), count);
+
+        if (count != 0)
+        {
+            EofException(sizeof(uint8_t));
+        }
+
+        _pointer = static_cast<uint32_t>(ptr - begin);
+    }
+
 protected:
     BOND_NORETURN void EofException(uint32_t size) const
     {
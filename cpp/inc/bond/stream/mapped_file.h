@@ -0,0 +1,85 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include <bond/core/blob.h>
+#include <bond/core/exception.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <string>
+#include <stdint.h>
+
+namespace bond
+{
+
+/// @brief Read-only memory mapping of a whole file
+///
+/// The pages of the file are loaded by the operating system when they are
+/// accessed and can be evicted under memory pressure, so files larger than
+/// the physical memory can be read. Blobs returned by GetBlob reference the
+/// mapping, which stays valid as long as there are references to it.
+class MappedFile
+    : boost::noncopyable
+{
+public:
+    /// @brief Expected pattern of access to the file, used to tune read-ahead
+    enum class Access
+    {
+        Normal,
+        Sequential,
+        Random
+    };
+
+    /// @brief Map the specified file
+    explicit MappedFile(const std::string& name, Access access = Access::Normal);
+
+    ~MappedFile();
+
+    /// @brief Pointer to the beginning of the mapped file
+    const char* data() const
+    {
+        return _data;
+    }
+
+    /// @brief Size of the mapped file
+    uint64_t size() const
+    {
+        return _size;
+    }
+
+private:
+    const char* _data;
+    uint64_t    _size;
+};
+
+
+/// @brief Returns a blob referencing the specified range of the mapped file
+///
+/// The blob holds a reference to the mapping.
+inline blob GetBlob(const boost::shared_ptr<const MappedFile>& file, uint64_t offset, uint32_t length)
+{
+    if (offset > file->size() || length > file->size() - offset)
+    {
+        BOND_THROW(StreamException,
+              "Mapped file range out of bounds: " << length << " bytes requested, offset: "
+              << offset << ", length: " << file->size());
+    }
+
+    return blob(boost::shared_ptr<const char[]>(file, file->data() + offset), length);
+}
+
+} // namespace bond
+
+
+#ifdef BOND_LIB_TYPE
+#if BOND_LIB_TYPE == BOND_LIB_TYPE_HEADER
+#include "detail/mapped_file_impl.h"
+#endif
+#else
+#error BOND_LIB_TYPE is undefined
+#endif
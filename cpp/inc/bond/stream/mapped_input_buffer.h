@@ -0,0 +1,245 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "input_buffer.h"
+#include "mapped_file.h"
+
+#include <bond/core/blob.h>
+#include <bond/core/exception.h>
+#include <bond/core/traits.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/static_assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace bond
+{
+
+/// @brief Input stream reading a memory mapped file
+///
+/// Values are decoded directly from the pages of the file, and blobs and
+/// bonded<T> values read from the stream reference the mapping instead of
+/// copying the data. Unlike InputBuffer, the stream is not limited to 4 GB,
+/// which allows reading a sequence of records from a file larger than the
+/// physical memory.
+class MappedInputBuffer
+{
+public:
+#if defined(_MSC_VER) && _MSC_VER < 1900
+    using range_type = blob;
+#endif
+
+    /// @brief Default constructor
+    MappedInputBuffer()
+        : _data(),
+          _pointer(),
+          _length()
+    {}
+
+    /// @brief Construct from a mapped file
+    explicit MappedInputBuffer(const boost::shared_ptr<const MappedFile>& file)
+        : _file(file),
+          _data(file->data()),
+          _pointer(),
+          _length(file->size())
+    {}
+
+    /// @brief Map the specified file
+    ///
+    /// By default the operating system is advised that the file is read
+    /// sequentially, which increases read-ahead and lets pages that were
+    /// read be evicted first.
+    explicit MappedInputBuffer(const std::string& name,
+                               MappedFile::Access access = MappedFile::Access::Sequential)
+        : _file(boost::make_shared<MappedFile>(name, access)),
+          _data(_file->data()),
+          _pointer(),
+          _length(_file->size())
+    {}
+
+
+    bool operator==(const MappedInputBuffer& rhs) const
+    {
+        return _file == rhs._file
+            && _pointer == rhs._pointer;
+    }
+
+
+    void Read(uint8_t& value)
+    {
+        if (_length == _pointer)
+        {
+            EofException(sizeof(uint8_t));
+        }
+
+        value = static_cast<uint8_t>(_data[_pointer++]);
+    }
+
+
+    template <typename T>
+    void Read(T& value)
+    {
+        BOOST_STATIC_ASSERT(std::is_arithmetic<T>::value || std::is_enum<T>::value);
+
+        if (sizeof(T) > _length - _pointer)
+        {
+            EofException(sizeof(T));
+        }
+
+        std::memcpy(&value, _data + _pointer, sizeof(T));
+        _pointer += sizeof(T);
+    }
+
+
+    void Read(void *buffer, uint32_t size)
+    {
+        if (size > _length - _pointer)
+        {
+            EofException(size);
+        }
+
+        std::memcpy(buffer, _data + _pointer, size);
+        _pointer += size;
+    }
+
+
+    void Read(blob& blob, uint32_t size)
+    {
+        if (size > _length - _pointer)
+        {
+            EofException(size);
+        }
+
+        blob = GetBlob(_file, _pointer, size);
+        _pointer += size;
+    }
+
+
+    void Skip(uint32_t size)
+    {
+        if (size > _length - _pointer)
+        {
+            return;
+        }
+
+        _pointer += size;
+    }
+
+
+    /// @brief Check if the stream is at the end of the mapped file.
+    bool IsEof() const
+    {
+        return _pointer == _length;
+    }
+
+
+    /// @brief Returns the current offset in the mapped file.
+    uint64_t GetPosition() const
+    {
+        return _pointer;
+    }
+
+
+    template <typename T>
+    void ReadVariableUnsigned(T& value)
+    {
+        if (_length - _pointer > sizeof(T) * 8 / 7)
+        {
+            const char* ptr = _data + _pointer;
+            input_buffer::VariableUnsignedUnchecked<T, 0>::Read(ptr, value);
+            _pointer = static_cast<uint64_t>(ptr - _data);
+        }
+        else
+        {
+            GenericReadVariableUnsigned(*this, value);
+        }
+    }
+
+
+    template <typename T>
+    void ReadVariableUnsigned(T* values, uint32_t count)
+    {
+        T* const values_end = values + count;
+        const char* const begin = _data + _pointer;
+
+        // Bound the range by what the values can occupy so that its size
+        // fits in the 32-bit arithmetic of the decoder.
+        const uint64_t max_size = static_cast<uint64_t>(count) * ((sizeof(T) * 8 + 6) / 7 + 1);
+        const char* const end = begin + (std::min)(max_size, _length - _pointer);
+
+        _pointer += static_cast<uint64_t>(
+            input_buffer::VariableUnsignedArrayUnchecked(begin, end, values, values_end) - begin);
+
+        // Values close to the end of the file are decoded one at a time
+        for (; values != values_end; ++values)
+        {
+            ReadVariableUnsigned(*values);
+        }
+    }
+
+
+    void SkipVariableUnsigned(uint32_t count)
+    {
+        const char* const ptr = input_buffer::SkipVariableUnsigned(
+            _data + _pointer, _data + _length, count);
+
+        if (count != 0)
+        {
+            EofException(sizeof(uint8_t));
+        }
+
+        _pointer = static_cast<uint64_t>(ptr - _data);
+    }
+
+protected:
+    BOND_NORETURN void EofException(uint32_t size) const
+    {
+        BOND_THROW(StreamException,
+              "Read out of bounds: " << size << " bytes requested, offset: "
+              << _pointer << ", length: " << _length);
+    }
+
+    boost::shared_ptr<const MappedFile> _file;
+    const char* _data;
+    uint64_t    _pointer;
+    uint64_t    _length;
+
+
+    friend MappedInputBuffer GetCurrentBuffer(const MappedInputBuffer& input)
+    {
+        return input;
+    }
+
+    friend blob GetBufferRange(const MappedInputBuffer& begin, const MappedInputBuffer& end);
+};
+
+
+/// @brief Returns the data between the two positions of the stream.
+///
+/// The result references the memory of the mapped file.
+inline blob GetBufferRange(const MappedInputBuffer& begin, const MappedInputBuffer& end)
+{
+    BOOST_ASSERT(begin._file == end._file);
+    BOOST_ASSERT(begin._pointer <= end._pointer);
+
+    return GetBlob(begin._file, begin._pointer, static_cast<uint32_t>(end._pointer - begin._pointer));
+}
+
+
+inline InputBuffer CreateInputBuffer(const MappedInputBuffer& /*other*/, const blob& blob)
+{
+    return InputBuffer(blob);
+}
+
+
+BOND_DEFINE_BUFFER_MAGIC(MappedInputBuffer, 0x4d46 /*MF*/);
+
+} // namespace bond
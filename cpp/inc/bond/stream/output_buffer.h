@@ -81,6 +81,53 @@ struct VariableUnsignedUnchecked<uint16_t, 3>
     }
 };
 
+
+// Writes an array of variable encoded unsigned integers and returns the
+// pointer past the last byte written. The caller must ensure that the buffer
+// can hold sizeof(T) * 8 / 7 + 1 bytes per value.
+template <typename T>
+inline char* VariableUnsignedArrayUnchecked(char* p, const T* values, const T* const values_end)
+{
+    BOOST_STATIC_ASSERT(std::is_unsigned<T>::value);
+
+    while (values_end - values >= 8)
+    {
+        T bits = 0;
+
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            bits |= values[i];
+        }
+
+        if (bits < 0x80)
+        {
+            // Fast path for runs of values encoded in a single byte
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                p[i] = static_cast<char>(values[i]);
+            }
+
+            p += 8;
+        }
+        else
+        {
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                p += VariableUnsignedUnchecked<T, 1>::Write(p, values[i]);
+            }
+        }
+
+        values += 8;
+    }
+
+    while (values != values_end)
+    {
+        p += VariableUnsignedUnchecked<T, 1>::Write(p, *values++);
+    }
+
+    return p;
+}
+
 }
 
 /// @brief Memory backed output stream
@@ -95,6 +142,7 @@ public:
           _bufferSize(0),
           _rangeSize(0),
           _rangeOffset(0),
+          _blobsSize(0),
           _minChainningSize(32),
           _maxChainLength((uint32_t)-1),
           _rangePtr(0),
@@ -114,6 +162,7 @@ public:
           _bufferSize(size),
           _rangeSize(0),
           _rangeOffset(0),
+          _blobsSize(0),
           _minChainningSize(minChanningSize),
           _maxChainLength(maxChainLength),
           _rangePtr(_buffer.get()),
@@ -135,6 +184,7 @@ public:
           _bufferSize(reserveSize),
           _rangeSize(0),
           _rangeOffset(0),
+          _blobsSize(0),
           _minChainningSize(minChanningSize),
           _maxChainLength(maxChainLength),
           _rangePtr(_buffer.get()),
@@ -244,34 +294,8 @@ public:
             size -= sizePart;
             buffer += sizePart;
 
-            //
-            // snap current range to internal list of blobs, if not empty
-            //
-            if (_rangeSize > 0)
-            {
-                _blobs.emplace_back(_buffer, _rangeOffset, _rangeSize);
-            }
-
-            // cap buffer to prevent overflow
-            if (_bufferSize > ((std::numeric_limits<uint32_t>::max)() >> 1))
-            {
-                throw std::bad_alloc();
-            }
+            Grow(size);
 
-            //
-            // grow buffer by 50% (at least 4096 bytes for initial buffer)
-            // and enough to store left overs of specified buffer
-            //
-            _bufferSize += _bufferSize ? _bufferSize / 2 : 4096;
-            _bufferSize = (std::max)(_bufferSize, size);
-
-            _buffer = boost::allocate_shared_noinit<char[]>(_allocator, _bufferSize);
-
-            //
-            // init range
-            //
-            _rangeOffset = 0;
-            _rangePtr = _buffer.get();
             _rangeSize = size;
 
             //
@@ -299,6 +323,7 @@ public:
         if (_rangeSize > 0)
         {
             _blobs.emplace_back(_buffer, _rangeOffset, _rangeSize);
+            _blobsSize += _rangeSize;
 
             _rangeOffset += _rangeSize;
             _rangePtr += _rangeSize;
@@ -313,6 +338,47 @@ public:
         // attach specified blob to the end of the list
         //
         _blobs.push_back(buffer);
+        _blobsSize += buffer.size();
+    }
+
+    /// @brief Get the number of bytes written to the stream so far
+    uint32_t GetPosition() const
+    {
+        return _blobsSize + _rangeSize;
+    }
+
+    /// @brief Reserve a contiguous region of the specified size at the current
+    /// position of the stream and return a pointer to it.
+    ///
+    /// The content of the region is undefined until it is written through
+    /// the returned pointer, which may be done at any time before the buffers
+    /// of the stream are retrieved. This allows writers to back-patch values
+    /// that are not known until more data has been written, e.g. lengths.
+    char* Reserve(uint32_t size)
+    {
+        if (size + _rangeSize + _rangeOffset > _bufferSize)
+        {
+            Grow(size);
+        }
+
+        char* ptr = _rangePtr + _rangeSize;
+        _rangeSize += size;
+        return ptr;
+    }
+
+    /// @brief Discard the content of the stream, keeping the current buffer
+    /// for the data written next.
+    ///
+    /// Blobs previously returned by GetBuffer or GetBuffers may reference the
+    /// current buffer, which is overwritten by subsequent writes, so they
+    /// must not be used after calling this function.
+    void Clear()
+    {
+        _blobs.clear();
+        _blobsSize = 0;
+        _rangeSize = 0;
+        _rangeOffset = 0;
+        _rangePtr = _buffer.get();
     }
 
     void Flush()
@@ -336,7 +402,83 @@ public:
         }
     }
 
+    template<typename T>
+    void WriteVariableUnsigned(const T* values, uint32_t count)
+    {
+        const uint32_t max_length = sizeof(T) * 8 / 7 + 1;
+        const uint32_t max_chunk = 16 * 1024 * 1024;
+
+        while (count != 0)
+        {
+            // Encode as many values as are guaranteed to fit in the current
+            // buffer, growing it once for the remainder of the array.
+            const uint32_t available = (_bufferSize - _rangeSize - _rangeOffset) / max_length;
+
+            if (available == 0)
+            {
+                if (_rangeSize + _rangeOffset == _bufferSize)
+                {
+                    // Very long arrays may need to grow the buffer again
+                    Grow((std::min)(count, max_chunk) * max_length);
+                }
+                else
+                {
+                    // Fill up the end of the current buffer
+                    WriteVariableUnsigned(*values++);
+                    --count;
+                }
+
+                continue;
+            }
+
+            const uint32_t size = (std::min)(count, available);
+            char* const ptr = _rangePtr + _rangeSize;
+
+            _rangeSize += static_cast<uint32_t>(
+                output_buffer::VariableUnsignedArrayUnchecked(ptr, values, values + size) - ptr);
+
+            values += size;
+            count -= size;
+        }
+    }
+
 protected:
+    // Snaps the current range and allocates a new buffer that can hold at
+    // least the specified number of bytes.
+    void Grow(uint32_t size)
+    {
+        //
+        // snap current range to internal list of blobs, if not empty
+        //
+        if (_rangeSize > 0)
+        {
+            _blobs.emplace_back(_buffer, _rangeOffset, _rangeSize);
+            _blobsSize += _rangeSize;
+        }
+
+        // cap buffer to prevent overflow
+        if (_bufferSize > ((std::numeric_limits<uint32_t>::max)() >> 1))
+        {
+            throw std::bad_alloc();
+        }
+
+        //
+        // grow buffer by 50% (at least 4096 bytes for initial buffer)
+        // and enough to store left overs of specified buffer
+        //
+        _bufferSize += _bufferSize ? _bufferSize / 2 : 4096;
+        _bufferSize = (std::max)(_bufferSize, size);
+
+        _buffer = boost::allocate_shared_noinit<char[]>(_allocator, _bufferSize);
+
+        //
+        // init range
+        //
+        _rangeOffset = 0;
+        _rangePtr = _buffer.get();
+        _rangeSize = 0;
+    }
+
     // allocator instance
     A _allocator;
 
@@ -352,6 +494,9 @@ protected:
     // offset of current buffer range
     uint32_t _rangeOffset;
 
+    // total size of the blobs in the internal list
+    uint32_t _blobsSize;
+
     // smallest blob size that will be chained rather than copied
     uint32_t _minChainningSize;
 
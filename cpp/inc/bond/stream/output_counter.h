@@ -101,6 +101,15 @@ public:
         VariableUnsigned<T, 1>::Write(_count, value >> 7);
     }
 
+    template<typename T>
+    void WriteVariableUnsigned(const T* values, uint32_t count)
+    {
+        for (const T* const end = values + count; values != end; ++values)
+        {
+            VariableUnsigned<T, 1>::Write(_count, *values >> 7);
+        }
+    }
+
     Buffer GetBuffer() const
     {
         return { GetCount() };
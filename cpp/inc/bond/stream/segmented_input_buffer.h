@@ -0,0 +1,331 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/config.h>
+
+#include "input_buffer.h"
+
+#include <bond/core/blob.h>
+#include <bond/core/detail/checked.h>
+#include <bond/core/exception.h>
+#include <bond/core/traits.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/static_assert.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace bond
+{
+
+/// @brief Memory backed input stream over a sequence of non-contiguous blobs
+///
+/// SegmentedInputBuffer reads directly from the blobs without first merging
+/// them into one contiguous buffer. Blobs and bonded<T> values read from the
+/// stream reference the memory of the segments whenever the data they cover
+/// doesn't span multiple segments.
+class SegmentedInputBuffer
+{
+public:
+#if defined(_MSC_VER) && _MSC_VER < 1900
+    using range_type = blob;
+#endif
+
+    typedef std::vector<blob> Segments;
+
+    /// @brief Default constructor
+    SegmentedInputBuffer()
+        : _index(),
+          _pointer(),
+          _position(),
+          _length()
+    {}
+
+    /// @brief Construct from a sequence of blobs
+    ///
+    /// SegmentedInputBuffer holds references to the blobs. Assuming that the
+    /// blobs were created using ref-counted smart pointers this assures proper
+    /// lifetime management for the underlying memory buffers.
+    explicit SegmentedInputBuffer(Segments segments)
+        : _index(),
+          _pointer(),
+          _position(),
+          _length()
+    {
+        // Empty segments are dropped so that the current segment is never
+        // empty, unless the stream is at the end.
+        segments.erase(
+            std::remove_if(segments.begin(), segments.end(), [](const blob& b) { return b.empty(); }),
+            segments.end());
+
+        for (const blob& segment : segments)
+        {
+            _length = detail::checked_add(_length, segment.length());
+        }
+
+        _segments = boost::make_shared<const Segments>(std::move(segments));
+        SetSegment(0);
+    }
+
+
+    bool operator==(const SegmentedInputBuffer& rhs) const
+    {
+        return _segments == rhs._segments
+            && _position == rhs._position
+            && _length == rhs._length;
+    }
+
+
+    void Read(uint8_t& value)
+    {
+        if (_current.length() == _pointer)
+        {
+            EofException(sizeof(uint8_t));
+        }
+
+        value = static_cast<const uint8_t>(_current.content()[_pointer]);
+        Advance(sizeof(uint8_t));
+    }
+
+
+    template <typename T>
+    void Read(T& value)
+    {
+        BOOST_STATIC_ASSERT(std::is_arithmetic<T>::value || std::is_enum<T>::value);
+
+        if (sizeof(T) < _current.length() - _pointer)
+        {
+            // Common case: the value is inside the current segment and doesn't
+            // end at its boundary.
+            std::memcpy(&value, _current.content() + _pointer, sizeof(T));
+            _pointer += sizeof(T);
+            _position += sizeof(T);
+        }
+        else
+        {
+            Read(&value, sizeof(T));
+        }
+    }
+
+
+    void Read(void *buffer, uint32_t size)
+    {
+        if (size > _length - _position)
+        {
+            EofException(size);
+        }
+
+        char* dest = static_cast<char*>(buffer);
+
+        while (size != 0)
+        {
+            const uint32_t part = (std::min)(size, _current.length() - _pointer);
+
+            std::memcpy(dest, _current.content() + _pointer, part);
+            Advance(part);
+
+            dest += part;
+            size -= part;
+        }
+    }
+
+
+    void Read(blob& blob, uint32_t size)
+    {
+        if (size > _length - _position)
+        {
+            EofException(size);
+        }
+
+        if (size <= _current.length() - _pointer)
+        {
+            blob.assign(_current, _pointer, size);
+            Advance(size);
+        }
+        else
+        {
+            // The data spans multiple segments and has to be copied into
+            // a contiguous buffer.
+            boost::shared_ptr<char[]> buffer = boost::make_shared_noinit<char[]>(size);
+
+            Read(buffer.get(), size);
+            blob.assign(buffer, size);
+        }
+    }
+
+
+    void Skip(uint32_t size)
+    {
+        if (size > _length - _position)
+        {
+            return;
+        }
+
+        while (size != 0)
+        {
+            const uint32_t part = (std::min)(size, _current.length() - _pointer);
+
+            Advance(part);
+            size -= part;
+        }
+    }
+
+
+    /// @brief Check if the stream is at the end of the underlying memory buffers.
+    bool IsEof() const
+    {
+        return _position == _length;
+    }
+
+
+    /// @brief Returns the current offset in the underlying memory buffers.
+    uint64_t GetPosition() const
+    {
+        return _position;
+    }
+
+
+    template <typename T>
+    void ReadVariableUnsigned(T& value)
+    {
+        if (_current.length() > _pointer + sizeof(T) * 8 / 7)
+        {
+            const char* ptr = _current.content() + _pointer;
+            input_buffer::VariableUnsignedUnchecked<T, 0>::Read(ptr, value);
+
+            Advance(static_cast<uint32_t>(ptr - _current.content()) - _pointer);
+        }
+        else
+        {
+            GenericReadVariableUnsigned(*this, value);
+        }
+    }
+
+
+    template <typename T>
+    void ReadVariableUnsigned(T* values, uint32_t count)
+    {
+        T* const values_end = values + count;
+
+        while (values != values_end)
+        {
+            const char* const begin = _current.content() + _pointer;
+            const char* const end = _current.content() + _current.length();
+
+            Advance(static_cast<uint32_t>(
+                input_buffer::VariableUnsignedArrayUnchecked(begin, end, values, values_end) - begin));
+
+            // Values close to the end of a segment are decoded one at a time
+            if (values != values_end)
+            {
+                ReadVariableUnsigned(*values++);
+            }
+        }
+    }
+
+
+    void SkipVariableUnsigned(uint32_t count)
+    {
+        while (count != 0)
+        {
+            if (_position == _length)
+            {
+                EofException(sizeof(uint8_t));
+            }
+
+            const char* const begin = _current.content() + _pointer;
+            const char* const end = _current.content() + _current.length();
+
+            // Values spanning segments are skipped in parts, the bytes
+            // ending the values are counted.
+            Advance(static_cast<uint32_t>(input_buffer::SkipVariableUnsigned(begin, end, count) - begin));
+        }
+    }
+
+protected:
+    BOND_NORETURN void EofException(uint32_t size) const
+    {
+        BOND_THROW(StreamException,
+              "Read out of bounds: " << size << " bytes requested, offset: "
+              << _position << ", length: " << _length);
+    }
+
+    void SetSegment(uint32_t index)
+    {
+        _index = index;
+        _pointer = 0;
+
+        if (_index < _segments->size())
+        {
+            _current = (*_segments)[_index];
+        }
+        else
+        {
+            _current = blob();
+        }
+    }
+
+    // Advances within the current segment, moving to the next segment when
+    // the end of the current one is reached.
+    void Advance(uint32_t size)
+    {
+        BOOST_ASSERT(size <= _current.length() - _pointer);
+
+        _pointer += size;
+        _position += size;
+
+        if (_pointer == _current.length() && _position != _length)
+        {
+            SetSegment(_index + 1);
+        }
+    }
+
+    boost::shared_ptr<const Segments> _segments;
+    blob        _current;
+    uint32_t    _index;
+    uint32_t    _pointer;
+    uint32_t    _position;
+    uint32_t    _length;
+
+
+    friend SegmentedInputBuffer GetCurrentBuffer(const SegmentedInputBuffer& input)
+    {
+        return input;
+    }
+
+    friend blob GetBufferRange(const SegmentedInputBuffer& begin, const SegmentedInputBuffer& end);
+};
+
+
+/// @brief Returns the data between the two positions of the stream.
+///
+/// The result references the memory of the segment if the range is inside
+/// a single segment, otherwise the data is copied into a contiguous blob.
+inline blob GetBufferRange(const SegmentedInputBuffer& begin, const SegmentedInputBuffer& end)
+{
+    BOOST_ASSERT(begin._segments == end._segments);
+    BOOST_ASSERT(begin._position <= end._position);
+
+    blob range;
+    SegmentedInputBuffer input(begin);
+
+    input.Read(range, end._position - begin._position);
+
+    return range;
+}
+
+
+inline SegmentedInputBuffer CreateInputBuffer(const SegmentedInputBuffer& /*other*/, const blob& blob)
+{
+    return SegmentedInputBuffer(SegmentedInputBuffer::Segments(1, blob));
+}
+
+
+BOND_DEFINE_BUFFER_MAGIC(SegmentedInputBuffer, 0x5349 /*SI*/);
+
+} // namespace bond
@@ -0,0 +1,11 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <bond/core/config.h>
+
+#if BOND_LIB_TYPE == BOND_LIB_TYPE_HEADER
+#error This source file should not be compiled for BOND_LIB_TYPE_HEADER
+#endif
+
+#include <bond/stream/mapped_file.h>
+#include <bond/stream/detail/mapped_file_impl.h>
@@ -40,12 +40,95 @@ TEST_CASE_BEGIN(BasicTypesLists)
 TEST_CASE_END
 
 
+// Values of every encoded length of variable integer encoding, following
+// a run of small values, to exercise bulk decoding of integer lists.
+template <typename T>
+vector<T> IntegerListValues()
+{
+    vector<T> values(64, static_cast<T>(1));
+
+    for (uint32_t shift = 0; shift < sizeof(T) * 8; ++shift)
+    {
+        const uint64_t value = uint64_t(1) << shift;
+
+        values.push_back(static_cast<T>(value));
+        values.push_back(static_cast<T>(value - 1));
+        values.push_back(static_cast<T>(0 - value));
+    }
+
+    values.push_back((std::numeric_limits<T>::min)());
+    values.push_back((std::numeric_limits<T>::max)());
+
+    return values;
+}
+
+
+template <typename Reader, typename Writer>
+struct IntegerListTests
+{
+    template <typename T>
+    void operator()(const T&)
+    {
+        BondStruct<vector<T> > from;
+        from.field = IntegerListValues<T>();
+
+        bond::OutputBuffer output;
+        Writer writer(output);
+
+        bond::Serialize(from, writer);
+
+        const bond::blob data = output.GetBuffer();
+
+        BondStruct<vector<T> > to;
+        bond::Deserialize(Reader(bond::InputBuffer(data)), to);
+
+        UT_Equal(from, to);
+
+        // Payload truncated in the middle of the list
+        UT_AssertThrows(
+            bond::Deserialize(Reader(bond::InputBuffer(data.range(0, data.size() / 2))), to),
+            bond::StreamException);
+
+        // Vectors may be written in bulk, which must produce the same payload
+        // as writing a list element by element, regardless of where the
+        // buffers of the output stream are split.
+        BondStruct<list<T> > elements;
+        elements.field.assign(from.field.begin(), from.field.end());
+
+        for (uint32_t size : { 1, 7, 100 })
+        {
+            bond::OutputBuffer bulk(size), single(size);
+            Writer bulk_writer(bulk), single_writer(single);
+
+            bond::Serialize(from, bulk_writer);
+            bond::Serialize(elements, single_writer);
+
+            UT_AssertIsTrue(bulk.GetBuffer() == data);
+            UT_AssertIsTrue(single.GetBuffer() == data);
+        }
+    }
+};
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(IntegerLists)
+{
+    typedef boost::mpl::list<uint16_t, uint32_t, uint64_t, int16_t, int32_t, int64_t> Types;
+
+    boost::mpl::for_each<Types>(IntegerListTests<Reader, Writer>());
+}
+TEST_CASE_END
+
+
 template <uint16_t N, typename Reader, typename Writer>
 void BasicTypesListTests(const char* name)
 {
     UnitTestSuite suite(name);
 
     AddTestCase<TEST_ID(N), BasicTypesLists, Reader, Writer>(suite, "Basic types lists");
+
+    AddTestCase<COND_TEST_ID(N, (!bond::uses_dom_parser<Reader>::value)),
+        IntegerLists, Reader, Writer>(suite, "Integer lists with values of all lengths");
 }
 
 
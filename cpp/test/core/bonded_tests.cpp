@@ -246,6 +246,78 @@ TEST_CASE_BEGIN(BondedSerialize)
 TEST_CASE_END
 
 
+template <typename Reader, typename Writer, typename T>
+void BondedProjection(const T& from, const bond::FieldSet& fields, const T& expected)
+{
+    bond::OutputBuffer output;
+    Writer writer(output);
+
+    bond::Serialize(from, writer);
+
+    const bond::bonded<T> bonded((Reader(output.GetBuffer())));
+
+    {
+        T to;
+        bonded.Deserialize(to, fields);
+
+        UT_Equal(to, expected);
+    }
+
+    // Projection using runtime schema
+    {
+        T to;
+        bond::bonded<void>(bonded).Deserialize(to, fields);
+
+        UT_Equal(to, expected);
+    }
+}
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(BondedProjections)
+{
+    {
+        const NestedStruct from = InitRandom<NestedStruct>();
+        NestedStruct expected;
+
+        expected.n1 = from.n1;
+        expected.m_int8 = from.m_int8;
+        expected.m_int16 = from.m_int16;
+
+        BondedProjection<Reader, Writer>(from, { 3, 24, 25 }, expected);
+    }
+
+    // Ids select fields of the struct and of its bases
+    {
+        const StructWithBase from = InitRandom<StructWithBase>();
+        StructWithBase expected;
+
+        expected.m_int32 = from.m_int32;
+        expected.m_uint32 = from.m_uint32;
+        static_cast<SimpleBase&>(expected).m_int32 = static_cast<const SimpleBase&>(from).m_int32;
+        static_cast<SimpleStruct&>(expected).m_int32 = static_cast<const SimpleStruct&>(from).m_int32;
+        static_cast<SimpleStruct&>(expected).m_str = static_cast<const SimpleStruct&>(from).m_str;
+        expected.m_int64 = from.m_int64;
+
+        BondedProjection<Reader, Writer>(from, { 2, 16, 17 }, expected);
+    }
+
+    // Required fields which are not selected are not validated
+    {
+        const Required from = InitRandom<Required>();
+        Required expected;
+
+        expected.x = from.x;
+
+        BondedProjection<Reader, Writer>(from, { 1 }, expected);
+    }
+
+    // Empty projection skips the whole struct
+    BondedProjection<Reader, Writer>(InitRandom<NestedListsStruct>(), bond::FieldSet(), NestedListsStruct());
+}
+TEST_CASE_END
+
+
 template <typename Reader, typename Writer, typename T1, typename T2>
 TEST_CASE_BEGIN(MarshaledBonded)
 {
@@ -328,6 +400,7 @@ void BondedTests(const char* name)
 
     AddTestCase<TEST_ID(N), BondedConstructors, Reader, Writer>(suite, "bonded constructors");
     AddTestCase<TEST_ID(N), BondedCasts, Reader, Writer, unittest::NestedStruct>(suite, "bonded casts");
+    AddTestCase<TEST_ID(N), BondedProjections, Reader, Writer>(suite, "bonded projections");
 
     TEST_SIMPLE_PROTOCOL(
         // Uses Simple protocol for random initialization of struct with bonded<T>
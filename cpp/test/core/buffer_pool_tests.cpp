@@ -0,0 +1,154 @@
+#include "precompiled.h"
+
+#include <bond/ext/buffer_pool.h>
+#include <bond/stream/output_buffer.h>
+
+#include <boost/test/unit_test.hpp>
+
+#ifdef _MSC_VER
+#pragma warning (push)
+#pragma warning (disable: 4100)
+#endif
+#include <boost/thread.hpp>
+#include <boost/thread/scoped_thread.hpp>
+#ifdef _MSC_VER
+#pragma warning (pop)
+#endif
+
+#include <memory>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(BufferPoolTests)
+
+BOOST_AUTO_TEST_CASE(SizeClassTests)
+{
+    bond::ext::buffer_pool pool;
+
+    void* block = pool.allocate(1000);
+    BOOST_CHECK_EQUAL(pool.misses(), 1u);
+
+    pool.deallocate(block, 1000);
+    BOOST_CHECK_EQUAL(pool.pooled_bytes(), 1024u);
+
+    // Sizes in the same size class reuse the block.
+    BOOST_CHECK_EQUAL(pool.allocate(900), block);
+    BOOST_CHECK_EQUAL(pool.hits(), 1u);
+    BOOST_CHECK_EQUAL(pool.pooled_bytes(), 0u);
+    pool.deallocate(block, 900);
+
+    // Sizes in a different size class don't.
+    void* other = pool.allocate(1100);
+    BOOST_CHECK_NE(other, block);
+    BOOST_CHECK_EQUAL(pool.misses(), 2u);
+    pool.deallocate(other, 1100);
+
+    BOOST_CHECK_EQUAL(pool.pooled_bytes(), 1024u + 1280u);
+
+    pool.clear();
+    BOOST_CHECK_EQUAL(pool.pooled_bytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(CapTests)
+{
+    bond::ext::buffer_pool pool{ 3 * 4096, 64 * 1024 };
+
+    std::vector<void*> blocks;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        blocks.push_back(pool.allocate(4096));
+    }
+
+    for (void* block : blocks)
+    {
+        pool.deallocate(block, 4096);
+    }
+
+    // Only the blocks under the cap are kept.
+    BOOST_CHECK_EQUAL(pool.pooled_bytes(), 3 * 4096u);
+
+    // Blocks larger than the largest size class bypass the pool.
+    void* large = pool.allocate(128 * 1024);
+    BOOST_CHECK_EQUAL(pool.misses(), 5u);
+    pool.deallocate(large, 128 * 1024);
+    BOOST_CHECK_EQUAL(pool.pooled_bytes(), 3 * 4096u);
+}
+
+BOOST_AUTO_TEST_CASE(OutputBufferTests)
+{
+    using PooledOutputBuffer = bond::OutputMemoryStream<bond::ext::pooled_allocator<char> >;
+
+    const auto pool = std::make_shared<bond::ext::buffer_pool>();
+    const bond::ext::pooled_allocator<char> allocator{ pool };
+
+    const SimpleStruct from = InitRandom<SimpleStruct>();
+    bond::blob data;
+
+    {
+        PooledOutputBuffer output{ allocator };
+        bond::CompactBinaryWriter<PooledOutputBuffer> writer{ output };
+
+        bond::Serialize(from, writer);
+        data = output.GetBuffer();
+    }
+
+    const uint64_t misses = pool->misses();
+    BOOST_CHECK_GT(misses, 0u);
+
+    // The buffer of the stream returns to the pool when the last blob
+    // referencing it is released.
+    const std::vector<char> bytes(data.content(), data.content() + data.size());
+    const bond::blob copy(bytes.data(), static_cast<uint32_t>(bytes.size()));
+    data.clear();
+    BOOST_CHECK_GT(pool->pooled_bytes(), 0u);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        PooledOutputBuffer output{ allocator };
+        bond::CompactBinaryWriter<PooledOutputBuffer> writer{ output };
+
+        bond::Serialize(from, writer);
+        BOOST_CHECK(output.GetBuffer() == copy);
+    }
+
+    BOOST_CHECK_EQUAL(pool->misses(), misses);
+    BOOST_CHECK_GT(pool->hits(), 0u);
+
+    SimpleStruct to;
+    bond::Deserialize(bond::CompactBinaryReader<bond::InputBuffer>(copy), to);
+    BOOST_CHECK((from == to));
+}
+
+BOOST_AUTO_TEST_CASE(ThreadSafetyTests)
+{
+    bond::ext::buffer_pool pool{ 1024 * 1024 };
+
+    {
+        std::vector<boost::scoped_thread<> > threads;
+
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&pool, t]
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    const std::size_t size = 64 + (i % 16) * 100 + t;
+                    char* block = static_cast<char*>(pool.allocate(size));
+
+                    block[0] = block[size - 1] = static_cast<char>(i);
+                    pool.deallocate(block, size);
+                }
+            });
+        }
+    }
+
+    BOOST_CHECK_EQUAL(pool.hits() + pool.misses(), 4000u);
+    BOOST_CHECK_LE(pool.pooled_bytes(), 1024 * 1024u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    return true;
+}
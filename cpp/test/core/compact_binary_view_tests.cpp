@@ -0,0 +1,279 @@
+#include "precompiled.h"
+
+#include <bond/protocol/compact_binary_view.h>
+
+#include <bond/core/box.h>
+
+#include <boost/thread/scoped_thread.hpp>
+
+#include <iterator>
+
+
+template <typename T>
+bond::blob SerializeCompactBinary(const T& value, uint16_t version)
+{
+    bond::OutputBuffer output;
+    bond::CompactBinaryWriter<bond::OutputBuffer> writer(output, version);
+
+    bond::Serialize(value, writer);
+
+    return output.GetBuffer();
+}
+
+
+void ViewFields(uint16_t version)
+{
+    const NestedStruct from = InitRandom<NestedStruct>();
+    const bond::CompactBinaryView view(SerializeCompactBinary(from, version), version);
+
+    bool m_bool;
+    int64_t m_int64;
+    std::string m_str;
+
+    UT_AssertIsTrue(view.GetField(35, m_str));
+    UT_AssertIsTrue(view.GetField(27, m_int64));
+    UT_AssertIsTrue(view.GetField(23, m_bool));
+
+    UT_AssertIsTrue(m_str == from.m_str);
+    UT_AssertAreEqual(m_int64, from.m_int64);
+    UT_AssertAreEqual(m_bool, from.m_bool);
+
+    // Type mismatch and missing field
+    int8_t m_int8;
+    UT_AssertIsFalse(view.GetField(23, m_int8));
+    UT_AssertIsFalse(view.GetField(100, m_int8));
+    UT_AssertIsFalse(view.Has(100));
+    UT_AssertAreEqual(view.GetFieldType(100), bond::BT_UNAVAILABLE);
+    UT_AssertAreEqual(view.GetFieldType(3), bond::BT_STRUCT);
+
+    // Nested structs
+    NestedStruct1 n1;
+    UT_AssertIsTrue(view.GetField(3, n1));
+    UT_Equal(n1, from.n1);
+
+    bond::bonded<NestedStruct1> bonded;
+    UT_AssertIsTrue(view.GetField(3, bonded));
+    UT_Equal(bonded.Deserialize(), from.n1);
+
+    bond::CompactBinaryView n2, n2n1, s;
+    UT_AssertIsTrue(view.GetField(2, n2));
+    UT_AssertIsTrue(n2.GetField(1, n2n1));
+    UT_AssertIsTrue(n2n1.GetField(1, s));
+
+    UT_AssertIsTrue(s.GetField(2, m_str));
+    UT_AssertIsTrue(m_str == from.n2.n1.s.m_str);
+
+    bond::CompactBinaryListView list;
+    UT_AssertIsFalse(view.GetField(3, list));
+}
+
+
+void ViewBase(uint16_t version)
+{
+    const StructWithBase from = InitRandom<StructWithBase>();
+    const bond::CompactBinaryView view(SerializeCompactBinary(from, version), version);
+
+    int32_t m_int32;
+    uint32_t m_uint32;
+    int64_t m_int64;
+    std::string m_str;
+
+    // Fields of derived struct hide fields of the base with the same id
+    UT_AssertIsTrue(view.GetField(16, m_int32));
+    UT_AssertAreEqual(m_int32, from.m_int32);
+
+    UT_AssertIsTrue(view.GetField(17, m_uint32));
+    UT_AssertAreEqual(m_uint32, from.m_uint32);
+    UT_AssertIsFalse(view.GetField(17, m_int64));
+
+    UT_AssertIsTrue(view.GetField(0, m_str));
+    UT_AssertIsTrue(m_str == from.m_str);
+
+    UT_AssertIsTrue(view.GetField(2, m_str));
+    UT_AssertIsTrue(m_str == static_cast<const SimpleStruct&>(from).m_str);
+}
+
+
+void ViewLists(uint16_t version)
+{
+    const NestedListsStruct from = InitRandom<NestedListsStruct>();
+    const bond::CompactBinaryView view(SerializeCompactBinary(from, version), version);
+
+    // List of structs
+    bond::CompactBinaryListView lSLS;
+    UT_AssertIsTrue(view.GetField(3, lSLS));
+    UT_AssertAreEqual(lSLS.size(), from.lSLS.size());
+    UT_AssertAreEqual(lSLS.GetElementType(), bond::BT_STRUCT);
+
+    for (uint32_t i = lSLS.size(); i-- != 0;)
+    {
+        SimpleListsStruct element;
+        UT_AssertIsTrue(lSLS.GetElement(i, element));
+        UT_Equal(element, *std::next(from.lSLS.begin(), i));
+    }
+
+    SimpleListsStruct element;
+    UT_AssertIsFalse(lSLS.GetElement(lSLS.size(), element));
+
+    // List of fixed-width values
+    bond::CompactBinaryListView vf;
+    UT_AssertIsTrue(view.GetField(6, vf));
+    UT_AssertAreEqual(vf.size(), from.vf.size());
+
+    for (uint32_t i = vf.size(); i-- != 0;)
+    {
+        float value;
+        UT_AssertIsTrue(vf.GetElement(i, value));
+        UT_AssertAreEqual(value, from.vf[i]);
+    }
+
+    // Nested lists
+    bond::CompactBinaryListView vvNS;
+    UT_AssertIsTrue(view.GetField(7, vvNS));
+    UT_AssertAreEqual(vvNS.size(), from.vvNS.size());
+
+    for (uint32_t i = 0; i < vvNS.size(); ++i)
+    {
+        bond::CompactBinaryListView vNS;
+        UT_AssertIsTrue(vvNS.GetElement(i, vNS));
+        UT_AssertAreEqual(vNS.size(), from.vvNS[i].size());
+
+        for (uint32_t j = 0; j < vNS.size(); ++j)
+        {
+            bond::CompactBinaryView ns;
+            UT_AssertIsTrue(vNS.GetElement(j, ns));
+
+            uint64_t m_uint64;
+            UT_AssertIsTrue(ns.GetField(31, m_uint64));
+            UT_AssertAreEqual(m_uint64, from.vvNS[i][j].m_uint64);
+        }
+
+        std::vector<NestedStruct> vNSValue;
+        UT_AssertIsTrue(vvNS.GetElement(i, vNSValue));
+        UT_Equal(vNSValue, from.vvNS[i]);
+    }
+}
+
+
+void ViewListsParallel(uint16_t version)
+{
+    std::vector<NestedStruct> from(1000);
+
+    for (auto& element : from)
+        element = InitRandom<NestedStruct>();
+
+    const bond::CompactBinaryView view(SerializeCompactBinary(bond::make_box(from), version), version);
+
+    bond::CompactBinaryListView list;
+    UT_AssertIsTrue(view.GetField(0, list));
+
+    // Ranges of elements
+    std::vector<NestedStruct> range(10);
+    UT_AssertIsTrue(list.GetElements(990, 10, range.begin()));
+    UT_AssertIsTrue(std::equal(range.begin(), range.end(), from.begin() + 990));
+    UT_AssertIsFalse(list.GetElements(991, 10, range.begin()));
+
+    // Tasks running on separate threads
+    {
+        std::vector<boost::scoped_thread<> > threads;
+        std::vector<NestedStruct> to;
+
+        UT_AssertIsTrue(bond::DeserializeParallel(list, to,
+            [&threads](const std::function<void()>& task)
+            {
+                threads.emplace_back(task);
+            }, 64));
+
+        UT_Equal(to, from);
+        UT_AssertAreEqual(threads.size(), 16u);
+    }
+
+    // Tasks running on the calling thread
+    {
+        std::vector<NestedStruct> to;
+
+        UT_AssertIsTrue(bond::DeserializeParallel(list, to,
+            [](const std::function<void()>& task) { task(); }));
+
+        UT_Equal(to, from);
+    }
+
+    // Tasks scheduled before the executor failed are waited for
+    {
+        std::vector<boost::scoped_thread<> > threads;
+        std::vector<NestedStruct> to;
+        bool thrown = false;
+
+        try
+        {
+            bond::DeserializeParallel(list, to,
+                [&threads](const std::function<void()>& task)
+                {
+                    if (threads.size() == 3)
+                        throw std::runtime_error("executor failed");
+
+                    threads.emplace_back(task);
+                }, 100);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+
+        UT_AssertIsTrue(thrown);
+        UT_AssertIsTrue(std::equal(to.begin(), to.begin() + 300, from.begin()));
+    }
+
+    std::vector<float> mismatch;
+    UT_AssertIsFalse(bond::DeserializeParallel(list, mismatch,
+        [](const std::function<void()>& task) { task(); }));
+}
+
+
+TEST_CASE_BEGIN(CompactBinaryViewFields)
+{
+    ViewFields(bond::v1);
+    ViewFields(bond::v2);
+    ViewBase(bond::v1);
+    ViewBase(bond::v2);
+}
+TEST_CASE_END
+
+
+TEST_CASE_BEGIN(CompactBinaryViewLists)
+{
+    ViewLists(bond::v1);
+    ViewLists(bond::v2);
+}
+TEST_CASE_END
+
+
+TEST_CASE_BEGIN(CompactBinaryViewListsParallel)
+{
+    ViewListsParallel(bond::v1);
+    ViewListsParallel(bond::v2);
+}
+TEST_CASE_END
+
+
+void CompactBinaryViewTestsInit()
+{
+    TEST_COMPACT_BINARY_PROTOCOL(
+        UnitTestSuite suite("CompactBinaryView");
+
+        AddTestCase<TEST_ID(0x2901),
+            CompactBinaryViewFields>(suite, "Struct fields");
+
+        AddTestCase<TEST_ID(0x2902),
+            CompactBinaryViewLists>(suite, "List elements");
+
+        AddTestCase<TEST_ID(0x2903),
+            CompactBinaryViewListsParallel>(suite, "Parallel list deserialization");
+    );
+}
+
+bool init_unit_test()
+{
+    CompactBinaryViewTestsInit();
+    return true;
+}
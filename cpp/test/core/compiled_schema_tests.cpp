@@ -0,0 +1,159 @@
+#include "precompiled.h"
+
+#include <bond/core/compiled_schema.h>
+
+
+// Transcoding with compiled schema must produce the same output as
+// transcoding with bonded<void> and the runtime schema.
+template <typename Writer, typename Reader, typename... Args>
+void CompiledTranscode(const bond::blob& data, const bond::RuntimeSchema& schema, Args... args)
+{
+    const bond::CompiledSchema compiled(schema);
+
+    bond::OutputBuffer expected;
+    {
+        Writer writer(expected, args...);
+        bond::bonded<void>(Reader(data), schema).Serialize(writer);
+    }
+
+    bond::OutputBuffer actual;
+    {
+        Writer writer(actual, args...);
+        Reader reader(data);
+        bond::Transcode(compiled, reader, writer);
+    }
+
+    UT_AssertIsTrue(expected.GetBuffer() == actual.GetBuffer());
+}
+
+
+template <typename Reader, typename Writer, typename From, typename Schema>
+void CompiledTranscodeAll(const From& from)
+{
+    bond::OutputBuffer output;
+    Writer writer(output);
+
+    bond::Serialize(from, writer);
+
+    const bond::blob data = output.GetBuffer();
+    const bond::RuntimeSchema schema = bond::GetRuntimeSchema<Schema>();
+
+    CompiledTranscode<bond::CompactBinaryWriter<bond::OutputBuffer>, Reader>(data, schema, bond::v1);
+    CompiledTranscode<bond::CompactBinaryWriter<bond::OutputBuffer>, Reader>(data, schema, bond::v2);
+    CompiledTranscode<bond::FastBinaryWriter<bond::OutputBuffer>, Reader>(data, schema);
+    CompiledTranscode<bond::SimpleJsonWriter<bond::OutputBuffer>, Reader>(data, schema);
+}
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(CompiledTranscoding)
+{
+    // Matching schema
+    CompiledTranscodeAll<Reader, Writer, NestedStruct, NestedStruct>(InitRandom<NestedStruct>());
+    CompiledTranscodeAll<Reader, Writer, NestedListsStruct, NestedListsStruct>(InitRandom<NestedListsStruct>());
+    CompiledTranscodeAll<Reader, Writer, NestedMaps, NestedMaps>(InitRandom<NestedMaps>());
+    CompiledTranscodeAll<Reader, Writer, NestedWithBase, NestedWithBase>(InitRandom<NestedWithBase>());
+
+    // Omitted optional fields
+    CompiledTranscodeAll<Reader, Writer, OptionalContainers, OptionalContainers>(OptionalContainers());
+
+    // Unknown fields and nested types not matching the schema
+    CompiledTranscodeAll<Reader, Writer, NestedStruct, NestedStructView>(InitRandom<NestedStruct>());
+    CompiledTranscodeAll<Reader, Writer, NestedListsStruct, NestedListsView>(InitRandom<NestedListsStruct>());
+    CompiledTranscodeAll<Reader, Writer, NestedMaps, NestedMapsView>(InitRandom<NestedMaps>());
+    CompiledTranscodeAll<Reader, Writer, NestedWithBase, NestedWithBaseView>(InitRandom<NestedWithBase>());
+
+    // Payload with deeper hierarchy than the schema
+    CompiledTranscodeAll<Reader, Writer, StructWithBase, SimpleStruct>(InitRandom<StructWithBase>());
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer, typename T>
+void CompiledSkip(const T& from)
+{
+    bond::OutputBuffer output;
+    Writer writer(output);
+
+    // Serialize a stream of records
+    bond::Serialize(T(), writer);
+    bond::Serialize(from, writer);
+
+    const bond::CompiledSchema compiled(bond::GetRuntimeSchema<T>());
+
+    Reader reader(output.GetBuffer());
+
+    bond::Skip(reader, compiled);
+
+    T to;
+    bond::bonded<T, Reader&>(reader).Deserialize(to);
+
+    UT_Equal(from, to);
+    UT_AssertIsTrue(reader.GetBuffer().IsEof());
+}
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(CompiledSkipping)
+{
+    CompiledSkip<Reader, Writer>(InitRandom<NestedStruct>());
+    CompiledSkip<Reader, Writer>(InitRandom<NestedListsStruct>());
+    CompiledSkip<Reader, Writer>(InitRandom<NestedMaps>());
+    CompiledSkip<Reader, Writer>(InitRandom<StructWithBase>());
+    CompiledSkip<Reader, Writer>(InitRandom<ListOfBase>());
+}
+TEST_CASE_END
+
+
+template <uint16_t N, typename Reader, typename Writer>
+void CompiledSchemaTaggedTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        CompiledTranscoding, Reader, Writer>(suite, "Compiled schema transcoding");
+
+    AddTestCase<TEST_ID(N),
+        CompiledSkipping, Reader, Writer>(suite, "Compiled schema skipping");
+}
+
+
+template <uint16_t N, typename Reader, typename Writer>
+void CompiledSchemaUntaggedTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        CompiledSkipping, Reader, Writer>(suite, "Compiled schema skipping");
+}
+
+
+void CompiledSchemaTestsInit()
+{
+    TEST_SIMPLE_PROTOCOL(
+        CompiledSchemaUntaggedTests<
+            0x2801,
+            bond::SimpleBinaryReader<bond::InputBuffer>,
+            bond::SimpleBinaryWriter<bond::OutputBuffer> >("Compiled schema tests for SimpleBinary");
+    );
+
+    TEST_COMPACT_BINARY_PROTOCOL(
+        CompiledSchemaTaggedTests<
+            0x2802,
+            bond::CompactBinaryReader<bond::InputBuffer>,
+            bond::CompactBinaryWriter<bond::OutputBuffer> >("Compiled schema tests for CompactBinary");
+    );
+
+    TEST_FAST_BINARY_PROTOCOL(
+        CompiledSchemaTaggedTests<
+            0x2803,
+            bond::FastBinaryReader<bond::InputBuffer>,
+            bond::FastBinaryWriter<bond::OutputBuffer> >("Compiled schema tests for FastBinary");
+    );
+}
+
+bool init_unit_test()
+{
+    CompiledSchemaTestsInit();
+    return true;
+}
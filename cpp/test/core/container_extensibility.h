@@ -59,6 +59,12 @@ namespace bond
     };
 
 
+    // SimpleList stores elements in a C array, see container_data
+    template <typename T>
+    struct is_contiguous_list_container<SimpleList<T> >
+        : std::true_type {};
+
+
     // enumerator
     template <typename T>
     class enumerator<SimpleList<T> >
@@ -131,6 +137,21 @@ void resize_list(SimpleList<T>& list, uint32_t size)
 }
 
 
+// container_data
+template <typename T>
+T* container_data(SimpleList<T>& list)
+{
+    return list.items;
+}
+
+
+template <typename T>
+const T* container_data(const SimpleList<T>& list)
+{
+    return list.items;
+}
+
+
 namespace bond
 {
     template <size_t N>
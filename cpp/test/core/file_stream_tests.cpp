@@ -0,0 +1,221 @@
+#include "precompiled.h"
+
+#include <bond/stream/file_input_stream.h>
+#include <bond/stream/file_output_stream.h>
+
+#include <cstdio>
+
+static const char* const file_name = "file_stream_tests.bin";
+
+
+FILE* OpenFile(const char* mode)
+{
+    FILE* file = nullptr;
+
+#ifdef _MSC_VER
+    // fopen is not considered "secure" under the compiler settings we use
+    // with MSVC.
+    fopen_s(&file, file_name, mode);
+#else
+    file = fopen(file_name, mode);
+#endif
+
+    UT_AssertIsNotNull(file);
+    return file;
+}
+
+
+template <typename Writer, typename T>
+void SerializeToFile(const T& obj, uint32_t bufferSize)
+{
+    FILE* file = OpenFile("wb");
+
+    {
+        bond::FileOutputStream output(file, bufferSize);
+        Writer writer(output);
+
+        bond::Serialize(obj, writer);
+        output.Flush();
+    }
+
+    fclose(file);
+}
+
+
+template <typename Reader, typename Writer, typename T>
+void FileRoundtrip(const T& from, uint32_t size)
+{
+    SerializeToFile<Writer>(from, size);
+
+    // The payload must be identical to the one written to memory
+    bond::OutputBuffer buffer;
+    typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type writer(buffer);
+
+    bond::Serialize(from, writer);
+
+    bond::blob expected = buffer.GetBuffer();
+    bond::blob actual;
+
+    bond::FileInputStream input(file_name, size);
+    input.Read(actual, expected.size());
+
+    UT_AssertIsTrue(actual == expected);
+    UT_AssertIsTrue(input.IsEof());
+
+    T to;
+    bond::Deserialize(Reader(bond::FileInputStream(file_name, size)), to);
+
+    UT_Equal(from, to);
+}
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(FileSerialization)
+{
+    const NestedStruct nested = InitRandom<NestedStruct>();
+    const NestedListsStruct lists = InitRandom<NestedListsStruct>();
+
+    for (uint32_t size : { 64, 100, 1000, 100000 })
+    {
+        FileRoundtrip<Reader, Writer>(nested, size);
+        FileRoundtrip<Reader, Writer>(lists, size);
+    }
+
+    std::remove(file_name);
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(FileBonded)
+{
+    // Marshaled bonded<T> in untagged protocols is read from an InputBuffer.
+    typedef bond::BuiltInProtocols::Append<Reader> Protocols;
+
+    const SimpleStruct simple = InitRandom<SimpleStruct>();
+
+    NestedStruct1OptionalBondedView from;
+    from.s = bond::bonded<SimpleStruct>(simple);
+
+    SerializeToFile<Writer>(from, 64);
+
+    for (uint32_t size : { 64, 100000 })
+    {
+        NestedStruct1OptionalBondedView to;
+        bond::Deserialize<Protocols>(Reader(bond::FileInputStream(file_name, size)), to);
+
+        SimpleStruct value;
+        to.s.template Deserialize<Protocols>(value);
+
+        UT_Equal(simple, value);
+    }
+
+    std::remove(file_name);
+}
+TEST_CASE_END
+
+
+TEST_CASE_BEGIN(FileBlocks)
+{
+    const char data[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+    FILE* file = OpenFile("wb");
+
+    {
+        bond::FileOutputStream output(file, 64);
+
+        output.Write(data, 10);
+        output.Write(bond::blob(data + 10, sizeof(data) - 10));
+    }
+
+    fclose(file);
+
+    bond::FileInputStream input(file_name, 64);
+    bond::blob value;
+    char buffer[sizeof(data)];
+
+    input.Read(value, 3);
+    UT_AssertIsTrue(value == bond::blob(data, 3));
+
+    // Blobs spanning blocks
+    input.Skip(57);
+    input.Read(value, 10);
+    UT_AssertIsTrue(value == bond::blob(data + 60, 10));
+
+    // Copies keep independent positions
+    bond::FileInputStream copy(input);
+
+    uint8_t byte;
+    input.Read(byte);
+    UT_AssertAreEqual(byte, static_cast<uint8_t>('8'));
+
+    input.Read(buffer, 2);
+    UT_AssertIsTrue(input.IsEof());
+    UT_AssertThrows(input.Read(byte), bond::StreamException);
+
+    copy.Read(byte);
+    UT_AssertAreEqual(byte, static_cast<uint8_t>('8'));
+
+    // Reads larger than a block bypass it
+    bond::FileInputStream large(file_name, 64);
+    large.Read(buffer, sizeof(data));
+    UT_AssertIsTrue(std::memcmp(buffer, data, sizeof(data)) == 0);
+    UT_AssertIsTrue(large.IsEof());
+
+    std::remove(file_name);
+}
+TEST_CASE_END
+
+
+template <uint16_t N, typename Reader, typename Writer>
+void FileStreamTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        FileSerialization, Reader, Writer>(suite, "File serialization");
+
+    AddTestCase<TEST_ID(N),
+        FileBonded, Reader, Writer>(suite, "File bonded<T>");
+}
+
+
+// Using a bond::InputBuffer for marshaled bonded protocols because
+// CreateInputBuffer returns bond::InputBuffer instead of FileInputStream.
+typedef bond::Protocols<bond::CompactBinaryReader<bond::InputBuffer> > MarshaledBondedProtocols;
+
+
+void FileStreamTestsInit()
+{
+    TEST_SIMPLE_PROTOCOL(
+        FileStreamTests<
+            0x2601,
+            bond::SimpleBinaryReader<bond::FileInputStream, MarshaledBondedProtocols>,
+            bond::SimpleBinaryWriter<bond::FileOutputStream> >("File streams tests for SimpleBinary");
+    );
+
+    TEST_COMPACT_BINARY_PROTOCOL(
+        FileStreamTests<
+            0x2602,
+            bond::CompactBinaryReader<bond::FileInputStream>,
+            bond::CompactBinaryWriter<bond::FileOutputStream> >("File streams tests for CompactBinary");
+    );
+
+    TEST_FAST_BINARY_PROTOCOL(
+        FileStreamTests<
+            0x2603,
+            bond::FastBinaryReader<bond::FileInputStream>,
+            bond::FastBinaryWriter<bond::FileOutputStream> >("File streams tests for FastBinary");
+    );
+
+    UnitTestSuite suite("File streams");
+
+    AddTestCase<TEST_ID(0x2604),
+        FileBlocks>(suite, "Blocks and end of stream");
+}
+
+bool init_unit_test()
+{
+    FileStreamTestsInit();
+    return true;
+}
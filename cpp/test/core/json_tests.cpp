@@ -4,6 +4,9 @@
 #include <boost/format.hpp>
 #include <boost/static_assert.hpp>
 
+#include <cmath>
+#include <cstdlib>
+#include <limits>
 #include <locale>
 #include <stdarg.h>
 #include <type_traits>
@@ -204,6 +207,9 @@ void StringTests(UnitTestSuite& suite)
 
     AddTestCase<TEST_ID(N),
         StreamDeserializationTest, NestedStruct, Reader, Writer>(suite, "Stream deserialization test");
+
+    AddTestCase<TEST_ID(N),
+        StreamArrayTest, Reader, Writer>(suite, "Stream array deserialization test");
 }
 
 TEST_CASE_BEGIN(ReaderOverCStr)
@@ -225,6 +231,236 @@ TEST_CASE_BEGIN(ReaderOverCStr)
 }
 TEST_CASE_END
 
+void DeserializeWideObject(bool runtimeSchema)
+{
+    // Objects with many members are searched through an index; the result
+    // must be the same as the linear search: the first member whose value
+    // type matches, found either by name or by the string form of the id.
+    const char* literalJson =
+        "{"
+        "  \"m_str\": 5,"
+        "  \"unknown1\": 1,"
+        "  \"unknown2\": \"unknown\","
+        "  \"m_int8\": -8,"
+        "  \"16\": 32,"
+        "  \"m_int32\": 33,"
+        "  \"m_uint8\": 8,"
+        "  \"m_uint16\": 16,"
+        "  \"m_uint32\": 32,"
+        "  \"m_uint64\": 64,"
+        "  \"m_double\": 1.5,"
+        "  \"m_bool\": true,"
+        "  \"m_str\": \"wide\""
+        "}";
+
+    bond::SimpleJsonReader<const char*> json_reader(literalJson);
+    SimpleStruct to;
+
+    if (runtimeSchema)
+        bond::Deserialize(json_reader, to, bond::GetRuntimeSchema<SimpleStruct>());
+    else
+        bond::Deserialize(json_reader, to);
+
+    BOOST_CHECK_EQUAL("wide", to.m_str);
+    BOOST_CHECK_EQUAL(-8, to.m_int8);
+    BOOST_CHECK_EQUAL(32, to.m_int32);
+    BOOST_CHECK_EQUAL(8, to.m_uint8);
+    BOOST_CHECK_EQUAL(16, to.m_uint16);
+    BOOST_CHECK_EQUAL(32u, to.m_uint32);
+    BOOST_CHECK_EQUAL(64u, to.m_uint64);
+    BOOST_CHECK_EQUAL(1.5, to.m_double);
+    BOOST_CHECK_EQUAL(true, to.m_bool);
+    BOOST_CHECK_EQUAL(0, to.m_int16);
+}
+
+// Returns a JSON object with more members than the linear search is used
+// for, in an order and with a number of unknown members depending on i.
+std::string WideObjectJson(int i)
+{
+    const std::string members[] =
+    {
+        boost::str(boost::format("\"m_int8\": %d") % (-1 - i)),
+        boost::str(boost::format("\"m_int16\": %d") % (100 + i)),
+        boost::str(boost::format("\"m_int32\": %d") % (1000 + i)),
+        boost::str(boost::format("\"m_int64\": %d") % (10000 + i)),
+        boost::str(boost::format("\"m_uint8\": %d") % i),
+        boost::str(boost::format("\"m_uint16\": %d") % (200 + i)),
+        boost::str(boost::format("\"m_uint32\": %d") % (2000 + i)),
+        boost::str(boost::format("\"m_uint64\": %d") % (20000 + i)),
+        boost::str(boost::format("\"m_double\": %d.5") % i),
+        boost::str(boost::format("\"m_str\": \"object%d\"") % i)
+    };
+
+    const int count = sizeof(members) / sizeof(members[0]);
+
+    std::string json = "{";
+
+    for (int k = 0; k < i % 4; ++k)
+    {
+        json += boost::str(boost::format("\"unknown%d\": %d, ") % k % k);
+    }
+
+    for (int k = 0; k < count; ++k)
+    {
+        if (k)
+            json += ", ";
+
+        json += members[(i + k) % count];
+    }
+
+    return json + "}";
+}
+
+void CheckWideObject(const SimpleStruct& obj, int i)
+{
+    BOOST_CHECK_EQUAL(-1 - i, obj.m_int8);
+    BOOST_CHECK_EQUAL(100 + i, obj.m_int16);
+    BOOST_CHECK_EQUAL(1000 + i, obj.m_int32);
+    BOOST_CHECK_EQUAL(10000 + i, obj.m_int64);
+    BOOST_CHECK_EQUAL(i, obj.m_uint8);
+    BOOST_CHECK_EQUAL(200 + i, obj.m_uint16);
+    BOOST_CHECK_EQUAL(2000u + i, obj.m_uint32);
+    BOOST_CHECK_EQUAL(20000u + i, obj.m_uint64);
+    BOOST_CHECK_EQUAL(i + 0.5, obj.m_double);
+    BOOST_CHECK_EQUAL(boost::str(boost::format("object%d") % i), obj.m_str);
+}
+
+void DeserializeWideObjectSequence()
+{
+    // Each top-level value is parsed into the same document, so the index
+    // built for one object must not be used for the next one.
+    const int count = 6;
+    std::string json;
+
+    for (int i = 0; i < count; ++i)
+    {
+        json += WideObjectJson(i) + "\n";
+    }
+
+    bond::SimpleJsonReader<const char*> json_reader(json.c_str());
+    bond::bonded<SimpleStruct, bond::SimpleJsonReader<const char*>&> stream(json_reader);
+
+    for (int i = 0; i < count; ++i)
+    {
+        SimpleStruct to;
+        stream.Deserialize(to);
+        CheckWideObject(to, i);
+    }
+}
+
+TEST_CASE_BEGIN(WideObject)
+{
+    DeserializeWideObject(false);
+    DeserializeWideObject(true);
+    DeserializeWideObjectSequence();
+}
+TEST_CASE_END
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(StreamArrayTest)
+{
+    const int count = 10;
+    SimpleStruct from[count];
+
+    typename Writer::Buffer output;
+
+    // Write a JSON array of records
+    {
+        Writer writer(output);
+
+        output.Write(" [ ", 3);
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (i)
+                output.Write(",\n", 2);
+
+            from[i] = InitRandom<SimpleStruct>();
+
+            NestedStruct1OptionalBondedView record;
+            record.s = bond::bonded<SimpleStruct>(from[i]);
+            Serialize(record, writer);
+        }
+
+        output.Write(" ] ", 3);
+    }
+
+    // Read the elements of the array one at a time
+    {
+        Reader reader(output.GetBuffer());
+        bond::bonded<NestedStruct1OptionalBondedView, Reader&> stream(reader);
+        std::vector<NestedStruct1OptionalBondedView> records;
+
+        reader.BeginArray();
+
+        while (reader.NextArrayElement())
+        {
+            records.push_back(NestedStruct1OptionalBondedView());
+            stream.Deserialize(records.back());
+        }
+
+        UT_AssertAreEqual(records.size(), static_cast<size_t>(count));
+
+        // bonded<T> fields still reference the elements they were read from
+        // after the following elements have been parsed.
+        for (int i = 0; i < count; ++i)
+        {
+            SimpleStruct record;
+            records[i].s.Deserialize(record);
+            UT_Equal(from[i], record);
+        }
+    }
+
+    // Elements with many members, in a different order and number in each
+    // element. Each element is parsed into the same document, so the index
+    // of the members of one element must not be used for the next one.
+    {
+        std::string json = "[";
+
+        for (int i = 0; i < count; ++i)
+        {
+            if (i)
+                json += ",\n";
+
+            json += WideObjectJson(i);
+        }
+
+        json += "]";
+
+        Reader reader(bond::blob(json.data(), static_cast<uint32_t>(json.size())));
+        bond::bonded<SimpleStruct, Reader&> stream(reader);
+        int i = 0;
+
+        reader.BeginArray();
+
+        for (; reader.NextArrayElement(); ++i)
+        {
+            SimpleStruct record;
+            stream.Deserialize(record);
+            CheckWideObject(record, i);
+        }
+
+        UT_AssertAreEqual(i, count);
+    }
+
+    // Empty array
+    {
+        Reader reader(bond::blob(" [ ] ", 5));
+
+        reader.BeginArray();
+        UT_AssertIsFalse(reader.NextArrayElement());
+    }
+
+    // Not an array
+    {
+        Reader reader(bond::blob(" {} ", 4));
+
+        UT_AssertThrows(reader.BeginArray(), bond::CoreException);
+    }
+}
+TEST_CASE_END
+
+
 TEST_CASE_BEGIN(DeepNesting)
 {
     const size_t nestingDepth = 10000;
@@ -245,6 +481,105 @@ TEST_CASE_BEGIN(DeepNesting)
 }
 TEST_CASE_END
 
+template <typename T>
+std::string WriteJson(const T& value)
+{
+    bond::OutputBuffer output;
+    bond::SimpleJsonWriter<bond::OutputBuffer> writer(output);
+
+    writer.Write(value);
+
+    const bond::blob data = output.GetBuffer();
+    return std::string(data.content(), data.size());
+}
+
+// Escaping done one character at a time, as by rapidjson::Writer
+std::string EscapeJson(const std::string& str)
+{
+    std::string result = "\"";
+
+    for (char ch : str)
+    {
+        switch (ch)
+        {
+            case '\"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\b': result += "\\b"; break;
+            case '\f': result += "\\f"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if (static_cast<uint8_t>(ch) < 0x20)
+                    result += boost::str(boost::format("\\u%04X") % static_cast<int>(ch));
+                else
+                    result += ch;
+        }
+    }
+
+    return result + "\"";
+}
+
+TEST_CASE_BEGIN(WriteEscapedStrings)
+{
+    // Every character at every position of strings spanning several 8-byte
+    // words, among characters which don't need escaping.
+    for (size_t length = 0; length < 20; ++length)
+    {
+        for (size_t pos = 0; pos <= length; ++pos)
+        {
+            for (int ch = 0; ch < 256; ++ch)
+            {
+                std::string str;
+
+                for (size_t i = 0; i < length; ++i)
+                    str += static_cast<char>(i == pos ? ch : 'a' + i % 26);
+
+                UT_AssertIsTrue(WriteJson(str) == EscapeJson(str));
+            }
+        }
+    }
+
+    const std::string utf8 = "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82\t\xE4\xBD\xA0\xE5\xA5\xBD";
+    UT_AssertIsTrue(WriteJson(utf8) == EscapeJson(utf8));
+
+    // Wide strings with escaped characters around the end of the buffer
+    // used to escape them
+    for (size_t length = 240; length < 270; ++length)
+    {
+        const std::wstring wstr = std::wstring(length, L'x') + L"/\"\\\n\x1\x80\x263a";
+        const std::string expected = std::string(length, 'x') + "\\/\\\"\\\\\\n\\u0001\\u0080\\u263a";
+
+        UT_AssertIsTrue(WriteJson(wstr) == "\"" + expected + "\"");
+    }
+}
+TEST_CASE_END
+
+TEST_CASE_BEGIN(WriteNumbers)
+{
+    UT_AssertIsTrue(WriteJson(static_cast<int8_t>(-128)) == "-128");
+    UT_AssertIsTrue(WriteJson((std::numeric_limits<int64_t>::min)()) == "-9223372036854775808");
+    UT_AssertIsTrue(WriteJson((std::numeric_limits<uint64_t>::max)()) == "18446744073709551615");
+    UT_AssertIsTrue(WriteJson(static_cast<uint16_t>(0)) == "0");
+    UT_AssertIsTrue(WriteJson(EnumValue3) == "-10");
+
+    UT_AssertIsTrue(WriteJson(0.0) == "0.0");
+    UT_AssertIsTrue(WriteJson(-1.5) == "-1.5");
+    UT_AssertIsTrue(WriteJson(100.0) == "100.0");
+    UT_AssertIsTrue(WriteJson(1e300) == "1e300");
+    UT_AssertIsTrue(WriteJson(std::numeric_limits<double>::quiet_NaN()).empty());
+
+    // Doubles are written with enough digits to round-trip
+    for (int i = 1; i < 1000; ++i)
+    {
+        const double value = std::ldexp(1.0 / i, i % 200 - 100);
+        const std::string str = WriteJson(value);
+
+        UT_AssertAreEqual(std::strtod(str.c_str(), nullptr), value);
+    }
+}
+TEST_CASE_END
+
 void JSONTest::Initialize()
 {
     UnitTestSuite suite("Simple JSON test");
@@ -258,6 +593,9 @@ void JSONTest::Initialize()
 
     AddTestCase<TEST_ID(0x1c05), DeepNesting>(suite, "Deeply nested JSON struct");
     AddTestCase<TEST_ID(0x1c06), ReaderOverCStr>(suite, "SimpleJsonReader<const char*> specialization");
+    AddTestCase<TEST_ID(0x1c07), WideObject>(suite, "Field lookup in JSON object with many members");
+    AddTestCase<TEST_ID(0x1c08), WriteEscapedStrings>(suite, "Writing escaped strings");
+    AddTestCase<TEST_ID(0x1c09), WriteNumbers>(suite, "Writing numbers");
 }
 
 bool init_unit_test()
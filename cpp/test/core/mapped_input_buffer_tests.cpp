@@ -0,0 +1,197 @@
+#include "precompiled.h"
+
+#include <bond/stream/file_output_stream.h>
+#include <bond/stream/mapped_input_buffer.h>
+
+#include <cstdio>
+
+static const char* const file_name = "mapped_input_buffer_tests.bin";
+
+
+void WriteFile(const bond::blob& data)
+{
+    FILE* file = nullptr;
+
+#ifdef _MSC_VER
+    // fopen is not considered "secure" under the compiler settings we use
+    // with MSVC.
+    fopen_s(&file, file_name, "wb");
+#else
+    file = fopen(file_name, "wb");
+#endif
+
+    UT_AssertIsNotNull(file);
+
+    {
+        bond::FileOutputStream output(file);
+
+        output.Write(data);
+        output.Flush();
+    }
+
+    fclose(file);
+}
+
+
+template <typename Reader, typename Writer, typename T>
+void MappedRoundtrip(const T& from)
+{
+    bond::OutputBuffer output;
+    Writer writer(output);
+
+    // Serialize a stream of records
+    bond::Serialize(from, writer);
+    bond::Serialize(from, writer);
+
+    WriteFile(output.GetBuffer());
+
+    bond::MappedInputBuffer input(file_name);
+    Reader reader(input);
+    bond::bonded<T, Reader&> bonded(reader);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        T to;
+        bonded.Deserialize(to);
+
+        UT_Equal(from, to);
+    }
+
+    UT_AssertIsTrue(reader.GetBuffer().IsEof());
+}
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(MappedDeserialization)
+{
+    MappedRoundtrip<Reader, Writer>(InitRandom<NestedStruct>());
+    MappedRoundtrip<Reader, Writer>(InitRandom<NestedListsStruct>());
+
+    std::remove(file_name);
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(MappedBonded)
+{
+    // Marshaled bonded<T> in untagged protocols is read from an InputBuffer.
+    typedef bond::BuiltInProtocols::Append<Reader> Protocols;
+
+    const SimpleStruct simple = InitRandom<SimpleStruct>();
+
+    NestedStruct1OptionalBondedView from;
+    from.s = bond::bonded<SimpleStruct>(simple);
+
+    bond::OutputBuffer output;
+    Writer writer(output);
+
+    bond::Serialize(from, writer);
+
+    WriteFile(output.GetBuffer());
+
+    {
+        NestedStruct1OptionalBondedView to;
+        bond::Deserialize<Protocols>(Reader(bond::MappedInputBuffer(file_name)), to);
+
+        SimpleStruct value;
+        to.s.template Deserialize<Protocols>(value);
+
+        UT_Equal(simple, value);
+    }
+
+    std::remove(file_name);
+}
+TEST_CASE_END
+
+
+TEST_CASE_BEGIN(MappedBlobs)
+{
+    const char data[] = "0123456789";
+
+    WriteFile(bond::blob(data, sizeof(data)));
+
+    bond::blob value;
+
+    {
+        bond::MappedInputBuffer input(file_name, bond::MappedFile::Access::Random);
+
+        input.Read(value, 3);
+        UT_AssertIsTrue(value == bond::blob(data, 3));
+
+        uint8_t byte;
+        input.Skip(7);
+        input.Read(byte);
+        UT_AssertAreEqual(byte, static_cast<uint8_t>('\0'));
+        UT_AssertIsTrue(input.IsEof());
+
+        UT_AssertThrows(input.Read(byte), bond::StreamException);
+    }
+
+    // Blobs keep the mapping alive after the stream is destroyed
+    UT_AssertIsTrue(value == bond::blob(data, 3));
+    value = bond::blob();
+
+    // Empty files can be read
+    WriteFile(bond::blob());
+    UT_AssertIsTrue(bond::MappedInputBuffer(file_name).IsEof());
+
+    std::remove(file_name);
+
+    UT_AssertThrows(bond::MappedInputBuffer missing(file_name), bond::StreamException);
+}
+TEST_CASE_END
+
+
+template <uint16_t N, typename Reader, typename Writer>
+void MappedInputBufferTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        MappedDeserialization, Reader, Writer>(suite, "Mapped deserialization");
+
+    AddTestCase<TEST_ID(N),
+        MappedBonded, Reader, Writer>(suite, "Mapped bonded<T>");
+}
+
+
+// Using a bond::InputBuffer for marshaled bonded protocols because
+// CreateInputBuffer returns bond::InputBuffer instead of MappedInputBuffer.
+typedef bond::Protocols<bond::CompactBinaryReader<bond::InputBuffer> > MarshaledBondedProtocols;
+
+
+void MappedInputBufferTestsInit()
+{
+    TEST_SIMPLE_PROTOCOL(
+        MappedInputBufferTests<
+            0x2701,
+            bond::SimpleBinaryReader<bond::MappedInputBuffer, MarshaledBondedProtocols>,
+            bond::SimpleBinaryWriter<bond::OutputBuffer> >("MappedInputBuffer tests for SimpleBinary");
+    );
+
+    TEST_COMPACT_BINARY_PROTOCOL(
+        MappedInputBufferTests<
+            0x2702,
+            bond::CompactBinaryReader<bond::MappedInputBuffer>,
+            bond::CompactBinaryWriter<bond::OutputBuffer> >("MappedInputBuffer tests for CompactBinary");
+    );
+
+    TEST_FAST_BINARY_PROTOCOL(
+        MappedInputBufferTests<
+            0x2703,
+            bond::FastBinaryReader<bond::MappedInputBuffer>,
+            bond::FastBinaryWriter<bond::OutputBuffer> >("MappedInputBuffer tests for FastBinary");
+    );
+
+    UnitTestSuite suite("MappedInputBuffer");
+
+    AddTestCase<TEST_ID(0x2704),
+        MappedBlobs>(suite, "Blobs and end of stream");
+}
+
+bool init_unit_test()
+{
+    MappedInputBufferTestsInit();
+    return true;
+}
@@ -102,6 +102,27 @@ void Transcoding(uint16_t version1 = bond::v1, uint16_t version2 = bond::v1)
 
         UT_Equal_P(from, to, Protocols);
     }
+
+    // Compile-time schema and protocols
+    {
+        Reader1 reader(Serialize<Reader1, Writer1, Protocols>(from, version1));
+
+        typename Writer2::Buffer output_buffer;
+
+        Factory<Writer2>::Call(output_buffer, version2, [&reader](Writer2& writer)
+        {
+            bond::Transcode<BondedType, Protocols>(reader, writer);
+        });
+
+        typename Reader2::Buffer input_buffer(output_buffer.GetBuffer());
+        bond::bonded<To> bonded_to(Factory<Reader2>::Create(input_buffer, version2));
+
+        To to = InitRandom<To, Protocols>();
+
+        bonded_to.template Deserialize<Protocols>(to);
+
+        UT_Equal_P(from, to, Protocols);
+    }
 }
 
 
@@ -207,6 +207,84 @@ TEST_CASE_BEGIN(StructLengthEncoding)
 }
 TEST_CASE_END
 
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(SinglePassStructLengthEncoding)
+{
+    // create single-pass writer using CB version 2
+    typename Writer::Buffer output_buffer;
+    Writer output(output_buffer, bond::v2, true);
+
+    UT_AssertAreEqual(output.NeedPass0(), false);
+
+    TestReadStruct<Reader, Writer>(output, output_buffer, 1000, 987654321);
+
+    // serialize nested structs in a single pass and read them back
+    NestedStruct from = InitRandom<NestedStruct>();
+    NestedStruct to;
+
+    typename Writer::Buffer nested_buffer(16);
+    Writer nested(nested_buffer, bond::v2, true);
+
+    bond::Serialize(from, nested);
+
+    typename Reader::Buffer input_buffer(nested_buffer.GetBuffer());
+    bond::Deserialize(Reader(input_buffer, bond::v2), to);
+
+    UT_Equal(from, to);
+}
+TEST_CASE_END
+
+// Compare the size and content of the payload serialized into a single
+// buffer of exact size with the payload of regular serialization
+template <typename Writer, typename T>
+void TestSerializedSize(const T& obj, Writer& output, uint16_t version)
+{
+    bond::Serialize(obj, output);
+
+    bond::blob expected = output.GetBuffer().GetBuffer();
+
+    UT_AssertAreEqual(bond::GetSerializedSize<Writer>(obj, version), expected.size());
+
+    bond::blob exact = bond::Serialize<Writer>(obj, version);
+
+    UT_AssertIsTrue(exact == expected);
+}
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(SerializedSize)
+{
+    NestedStruct obj = InitRandom<NestedStruct>();
+
+    typename Writer::Buffer output_buffer;
+    Writer output(output_buffer);
+
+    TestSerializedSize(obj, output, bond::default_version<Reader>::value);
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(SerializedSizeV2)
+{
+    NestedStruct obj = InitRandom<NestedStruct>();
+
+    // CB version 2 computes the size in the pass 0
+    typename Writer::Buffer output_buffer;
+    Writer output(output_buffer, bond::v2);
+
+    TestSerializedSize(obj, output, bond::v2);
+
+    // struct with base
+    typename Writer::Buffer base_buffer;
+    Writer base(base_buffer, bond::v2);
+
+    TestSerializedSize(InitRandom<NestedWithBase>(), base, bond::v2);
+}
+TEST_CASE_END
+
+
 template <typename Reader, typename Writer>
 TEST_CASE_BEGIN(StringEncoding)
 {
@@ -251,6 +329,15 @@ void GenericProtocolTest(const char* name)
     
     AddTestCase<COND_TEST_ID(N, (std::is_same<Writer, bond::CompactBinaryWriter<bond::OutputBuffer> >::value)), 
         StructLengthEncoding, Reader, Writer>(suite, "StructLength encoding");
+
+    AddTestCase<COND_TEST_ID(N, (std::is_same<Writer, bond::CompactBinaryWriter<bond::OutputBuffer> >::value)),
+        SinglePassStructLengthEncoding, Reader, Writer>(suite, "Single-pass StructLength encoding");
+
+    AddTestCase<TEST_ID(N),
+        SerializedSize, Reader, Writer>(suite, "Serialized size");
+
+    AddTestCase<COND_TEST_ID(N, (std::is_same<Writer, bond::CompactBinaryWriter<bond::OutputBuffer> >::value)),
+        SerializedSizeV2, Reader, Writer>(suite, "Serialized size, CB version 2");
 }
 
 
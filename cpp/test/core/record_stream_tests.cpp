@@ -0,0 +1,202 @@
+#include "precompiled.h"
+
+#include <bond/protocol/record_stream.h>
+
+#include <cstring>
+
+
+template <typename Writer>
+bond::blob WriteRecords(const std::vector<NestedStruct>& records, uint32_t blockSize, bool close = true)
+{
+    bond::OutputBuffer output;
+    bond::RecordStreamWriter<bond::OutputBuffer, Writer> writer(output, blockSize);
+
+    for (const NestedStruct& record : records)
+    {
+        writer.Write(record);
+    }
+
+    if (close)
+        writer.Close();
+    else
+        writer.Flush();
+
+    return output.GetBuffer();
+}
+
+
+template <typename Reader>
+std::vector<NestedStruct> ReadRecords(const bond::RecordStreamReader<Reader>& reader)
+{
+    std::vector<NestedStruct> records;
+
+    // Blocks are independent; read them in reverse order and put them back
+    // in order, as threads decoding ranges of blocks would.
+    for (size_t block = reader.GetBlockCount(); block-- != 0;)
+    {
+        std::vector<NestedStruct> block_records;
+        reader.ReadBlock(block, block_records);
+
+        UT_AssertAreEqual(block_records.size(), reader.GetRecordCount(block));
+        records.insert(records.begin(), block_records.begin(), block_records.end());
+    }
+
+    return records;
+}
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(RecordStreamRoundtrip)
+{
+    std::vector<NestedStruct> from;
+
+    for (int i = 0; i < 50; ++i)
+    {
+        from.push_back(InitRandom<NestedStruct>());
+    }
+
+    for (uint32_t blockSize : { 1, 1000, 10000, 1000000 })
+    {
+        const bond::blob data = WriteRecords<Writer>(from, blockSize);
+
+        // Located using the index
+        bond::RecordStreamReader<Reader> indexed(data);
+        UT_AssertIsTrue(indexed.IsIndexed());
+        UT_Equal(ReadRecords(indexed), from);
+
+        // Located by scanning a stream that wasn't closed
+        bond::RecordStreamReader<Reader> scanned(WriteRecords<Writer>(from, blockSize, false));
+        UT_AssertIsFalse(scanned.IsIndexed());
+        UT_AssertAreEqual(scanned.GetBlockCount(), indexed.GetBlockCount());
+        UT_Equal(ReadRecords(scanned), from);
+
+        // Last block written when the writer is destroyed
+        bond::OutputBuffer output;
+        {
+            bond::RecordStreamWriter<bond::OutputBuffer, Writer> writer(output, blockSize);
+
+            for (const NestedStruct& record : from)
+            {
+                writer.Write(record);
+            }
+        }
+
+        bond::RecordStreamReader<Reader> destroyed(output.GetBuffer());
+        UT_AssertAreEqual(destroyed.GetBlockCount(), indexed.GetBlockCount());
+        UT_Equal(ReadRecords(destroyed), from);
+    }
+
+    // Empty stream
+    bond::RecordStreamReader<Reader> empty(WriteRecords<Writer>(std::vector<NestedStruct>(), 1000));
+    UT_AssertIsTrue(empty.IsIndexed());
+    UT_AssertAreEqual(empty.GetBlockCount(), static_cast<size_t>(0));
+
+    // Protocol of the reader not matching the stream
+    UT_AssertThrows(bond::RecordStreamReader<bond::SimpleBinaryReader<bond::InputBuffer> >(
+        WriteRecords<bond::FastBinaryWriter<bond::OutputBuffer> >(from, 1000)), bond::StreamException);
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(RecordStreamResync)
+{
+    std::vector<NestedStruct> from;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        from.push_back(InitRandom<NestedStruct>());
+    }
+
+    // One record per block
+    const bond::blob data = WriteRecords<Writer>(from, 1);
+
+    bond::RecordStreamReader<Reader> reader(data);
+    UT_AssertAreEqual(reader.GetBlockCount(), from.size());
+
+    // Offset of the header of the 4th block
+    uint32_t offset = 8;
+
+    for (int block = 0; block < 3; ++block)
+    {
+        uint32_t size;
+        std::memcpy(&size, data.content() + offset + 12, sizeof(size));
+        offset += 20 + size;
+    }
+
+    // Corrupt the size in the block header and truncate the index
+    std::vector<char> buffer(data.content(), data.content() + data.size());
+    buffer[offset + 12] ^= 0x10;
+
+    bond::RecordStreamReader<Reader> corrupt(bond::blob(buffer.data(), data.size() - 4));
+    UT_AssertIsFalse(corrupt.IsIndexed());
+
+    std::vector<NestedStruct> expected(from);
+    expected.erase(expected.begin() + 3);
+
+    UT_AssertAreEqual(corrupt.GetBlockCount(), expected.size());
+    UT_Equal(ReadRecords(corrupt), expected);
+
+    // Corrupt the framing of the records of a block, detected when the block
+    // is decoded; the other blocks are not affected.
+    buffer[offset + 12] ^= 0x10;
+    buffer[offset + 23] ^= 0x10;
+
+    bond::RecordStreamReader<Reader> framing(bond::blob(buffer.data(), data.size()));
+    UT_AssertIsTrue(framing.IsIndexed());
+
+    std::vector<NestedStruct> records;
+    UT_AssertThrows(framing.ReadBlock(3, records), bond::StreamException);
+
+    records.clear();
+    framing.ReadBlock(4, records);
+    UT_Equal(records.front(), from[4]);
+
+    // Not a record stream
+    UT_AssertThrows(bond::RecordStreamReader<Reader>(data.range(1)), bond::StreamException);
+}
+TEST_CASE_END
+
+
+template <uint16_t N, typename Reader, typename Writer>
+void RecordStreamTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        RecordStreamRoundtrip, Reader, Writer>(suite, "Record stream roundtrip");
+
+    AddTestCase<TEST_ID(N),
+        RecordStreamResync, Reader, Writer>(suite, "Record stream resynchronization");
+}
+
+
+void RecordStreamTestsInit()
+{
+    TEST_SIMPLE_PROTOCOL(
+        RecordStreamTests<
+            0x2a01,
+            bond::SimpleBinaryReader<bond::InputBuffer>,
+            bond::SimpleBinaryWriter<bond::OutputBuffer> >("Record stream tests for SimpleBinary");
+    );
+
+    TEST_COMPACT_BINARY_PROTOCOL(
+        RecordStreamTests<
+            0x2a02,
+            bond::CompactBinaryReader<bond::InputBuffer>,
+            bond::CompactBinaryWriter<bond::OutputBuffer> >("Record stream tests for CompactBinary");
+    );
+
+    TEST_FAST_BINARY_PROTOCOL(
+        RecordStreamTests<
+            0x2a03,
+            bond::FastBinaryReader<bond::InputBuffer>,
+            bond::FastBinaryWriter<bond::OutputBuffer> >("Record stream tests for FastBinary");
+    );
+}
+
+bool init_unit_test()
+{
+    RecordStreamTestsInit();
+    return true;
+}
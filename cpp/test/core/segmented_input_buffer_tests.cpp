@@ -0,0 +1,209 @@
+#include "precompiled.h"
+
+#include <bond/stream/segmented_input_buffer.h>
+
+// Splits the blob into segments of the specified size.
+bond::SegmentedInputBuffer Split(const bond::blob& data, uint32_t size)
+{
+    bond::SegmentedInputBuffer::Segments segments;
+
+    // Add an empty segment, which must be ignored.
+    segments.push_back(bond::blob());
+
+    for (uint32_t offset = 0; offset < data.size(); offset += size)
+    {
+        segments.push_back(data.range(offset, (std::min)(size, data.size() - offset)));
+    }
+
+    return bond::SegmentedInputBuffer(segments);
+}
+
+
+template <typename Reader, typename Writer, typename T>
+void SegmentedRoundtrip(const T& from, uint32_t size)
+{
+    bond::OutputBuffer output;
+    Writer writer(output);
+
+    bond::Serialize(from, writer);
+
+    T to;
+    bond::Deserialize(Reader(Split(output.GetBuffer(), size)), to);
+
+    UT_Equal(from, to);
+}
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(SegmentedDeserialization)
+{
+    const NestedStruct nested = InitRandom<NestedStruct>();
+    const NestedListsStruct lists = InitRandom<NestedListsStruct>();
+
+    for (uint32_t size : { 1, 2, 3, 7, 64, 100000 })
+    {
+        SegmentedRoundtrip<Reader, Writer>(nested, size);
+        SegmentedRoundtrip<Reader, Writer>(lists, size);
+    }
+}
+TEST_CASE_END
+
+
+template <typename Reader, typename Writer>
+TEST_CASE_BEGIN(SegmentedBonded)
+{
+    // Marshaled bonded<T> in untagged protocols is read using Compact Binary.
+    typedef bond::BuiltInProtocols::Append<
+        Reader,
+        bond::CompactBinaryReader<bond::SegmentedInputBuffer> > Protocols;
+
+    const SimpleStruct simple = InitRandom<SimpleStruct>();
+
+    NestedStruct1OptionalBondedView from;
+    from.s = bond::bonded<SimpleStruct>(simple);
+
+    bond::OutputBuffer output;
+    Writer writer(output);
+
+    bond::Serialize(from, writer);
+
+    for (uint32_t size : { 1, 5, 100000 })
+    {
+        NestedStruct1OptionalBondedView to;
+        bond::Deserialize<Protocols>(Reader(Split(output.GetBuffer(), size)), to);
+
+        SimpleStruct value;
+        to.s.template Deserialize<Protocols>(value);
+
+        UT_Equal(simple, value);
+    }
+}
+TEST_CASE_END
+
+
+TEST_CASE_BEGIN(SegmentedBlobs)
+{
+    const char data[] = "0123456789";
+    const bond::blob input(data, sizeof(data));
+
+    bond::SegmentedInputBuffer segmented(Split(input, 4));
+    bond::blob value;
+
+    // Within a segment the blob references the memory of the segment.
+    segmented.Read(value, 3);
+    UT_AssertIsTrue(value.content() == data);
+
+    // Across segments the data is copied.
+    segmented.Read(value, 3);
+    UT_AssertIsTrue(value == input.range(3, 3));
+    UT_AssertIsTrue(value.content() != data + 3);
+
+    uint8_t byte;
+    segmented.Read(byte);
+    UT_AssertAreEqual(byte, static_cast<uint8_t>('6'));
+
+    segmented.Skip(3);
+    segmented.Read(byte);
+    UT_AssertAreEqual(byte, static_cast<uint8_t>('\0'));
+    UT_AssertIsTrue(segmented.IsEof());
+
+    UT_AssertThrows(segmented.Read(byte), bond::StreamException);
+}
+TEST_CASE_END
+
+
+template <typename Buffer>
+void SkipVarints(Buffer input, uint32_t count)
+{
+    bond::SkipVariableUnsigned(input, count);
+
+    uint64_t value;
+    bond::ReadVariableUnsigned(input, value);
+    UT_AssertAreEqual(value, static_cast<uint64_t>(0xdeadbeefdeadbeefULL));
+    UT_AssertIsTrue(input.IsEof());
+}
+
+
+TEST_CASE_BEGIN(SegmentedVarints)
+{
+    bond::OutputBuffer output;
+    uint32_t count = 0;
+
+    // Values of all encoded lengths, so that 8-byte words contain a varying
+    // number of terminating bytes.
+    for (uint64_t value = 1; value != 0; value <<= 3, count += 2)
+    {
+        bond::WriteVariableUnsigned(output, value - 1);
+        bond::WriteVariableUnsigned(output, count);
+    }
+
+    bond::WriteVariableUnsigned(output, static_cast<uint64_t>(0xdeadbeefdeadbeefULL));
+
+    const bond::blob data = output.GetBuffer();
+
+    SkipVarints(bond::InputBuffer(data), count);
+
+    for (uint32_t size = 1; size < 12; ++size)
+    {
+        SkipVarints(Split(data, size), count);
+    }
+
+    bond::InputBuffer input(data);
+    UT_AssertThrows(bond::SkipVariableUnsigned(input, count + 2), bond::StreamException);
+
+    bond::SegmentedInputBuffer segmented(Split(data, 5));
+    UT_AssertThrows(bond::SkipVariableUnsigned(segmented, count + 2), bond::StreamException);
+}
+TEST_CASE_END
+
+
+template <uint16_t N, typename Reader, typename Writer>
+void SegmentedInputBufferTests(const char* name)
+{
+    UnitTestSuite suite(name);
+
+    AddTestCase<TEST_ID(N),
+        SegmentedDeserialization, Reader, Writer>(suite, "Segmented deserialization");
+
+    AddTestCase<TEST_ID(N),
+        SegmentedBonded, Reader, Writer>(suite, "Segmented bonded<T>");
+}
+
+
+void SegmentedInputBufferTestsInit()
+{
+    TEST_SIMPLE_PROTOCOL(
+        SegmentedInputBufferTests<
+            0x2501,
+            bond::SimpleBinaryReader<bond::SegmentedInputBuffer>,
+            bond::SimpleBinaryWriter<bond::OutputBuffer> >("SegmentedInputBuffer tests for SimpleBinary");
+    );
+
+    TEST_COMPACT_BINARY_PROTOCOL(
+        SegmentedInputBufferTests<
+            0x2502,
+            bond::CompactBinaryReader<bond::SegmentedInputBuffer>,
+            bond::CompactBinaryWriter<bond::OutputBuffer> >("SegmentedInputBuffer tests for CompactBinary");
+    );
+
+    TEST_FAST_BINARY_PROTOCOL(
+        SegmentedInputBufferTests<
+            0x2503,
+            bond::FastBinaryReader<bond::SegmentedInputBuffer>,
+            bond::FastBinaryWriter<bond::OutputBuffer> >("SegmentedInputBuffer tests for FastBinary");
+    );
+
+    UnitTestSuite suite("SegmentedInputBuffer");
+
+    AddTestCase<TEST_ID(0x2504),
+        SegmentedBlobs>(suite, "Blobs and end of stream");
+
+    AddTestCase<TEST_ID(0x2505),
+        SegmentedVarints>(suite, "Skipping variable-length integers");
+}
+
+bool init_unit_test()
+{
+    SegmentedInputBufferTestsInit();
+    return true;
+}
@@ -46,6 +46,66 @@ TEST_CASE_BEGIN(SkipMismatchedIdTests)
 TEST_CASE_END
 
 
+#ifndef BOND_NO_SFINAE_EXPR
+void CountSkipped(uint16_t version)
+{
+    typedef bond::CompactBinaryReader<bond::InputBuffer> Reader;
+    typedef bond::CompactBinaryWriter<bond::OutputBuffer> Writer;
+
+    typedef SkipStruct<std::vector<uint64_t> > From;
+    typedef SkipStruct2<std::vector<uint64_t> > To;
+
+    From from;
+    from.field2 = 3.14;
+
+    for (uint64_t value = 1; value != 0; value <<= 5)
+    {
+        from.field1.push_back(value);
+    }
+
+    bond::OutputBuffer output;
+    Writer writer(output, version);
+    bond::Serialize(from, writer);
+
+    const bond::blob data = output.GetBuffer();
+
+    // The unknown field1 is skipped; the field headers, field2, the end of
+    // the struct and the v2 length prefix are read.
+    {
+        uint64_t skipped = 0;
+        Reader reader(data, version);
+        reader.SetSkipCounter(&skipped);
+
+        To to;
+        bond::Deserialize(reader, to);
+
+        UT_AssertAreEqual(from.field2, to.field2);
+        UT_AssertAreEqual(skipped, data.size() - (version == bond::v2 ? 13u : 12u));
+    }
+
+    // Skipping the whole struct counts all the data
+    {
+        uint64_t skipped = 0;
+        Reader reader(data, version);
+        reader.SetSkipCounter(&skipped);
+
+        reader.Skip(bond::BT_STRUCT);
+
+        UT_AssertIsTrue(reader.GetBuffer().IsEof());
+        UT_AssertAreEqual(skipped, data.size());
+    }
+}
+
+
+TEST_CASE_BEGIN(SkipCounter)
+{
+    CountSkipped(bond::v1);
+    CountSkipped(bond::v2);
+}
+TEST_CASE_END
+#endif
+
+
 template <uint16_t N, typename Reader, typename Writer>
 void SkipTests(const char* name)
 {
@@ -75,6 +135,15 @@ void SkipTest::InitializeMismatchedIdTests()
             bond::CompactBinaryWriter<bond::OutputBuffer> >("Skip mismatched id tests for CompactBinary");
     );
 
+#ifndef BOND_NO_SFINAE_EXPR
+    TEST_COMPACT_BINARY_PROTOCOL(
+        UnitTestSuite suite("Skipped bytes counter for CompactBinary");
+
+        AddTestCase<TEST_ID(0xa04),
+            SkipCounter>(suite, "Unknown fields and skipped structs");
+    );
+#endif
+
     TEST_FAST_BINARY_PROTOCOL(
         SkipTests<
             0xa03,
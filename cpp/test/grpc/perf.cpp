@@ -0,0 +1,19 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "../perf/benchmark.h"
+
+namespace perf
+{
+    void InitServerBenchmarks();
+    void InitThreadPoolBenchmarks();
+}
+
+
+int main(int argc, char* argv[])
+{
+    perf::InitServerBenchmarks();
+    perf::InitThreadPoolBenchmarks();
+
+    return perf::Main(argc, argv, "grpc_perf", 2, 48, perf::Throughput::Operations);
+}
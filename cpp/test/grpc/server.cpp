@@ -3,6 +3,8 @@
 
 #include "services_grpc.h"
 
+#include <bond/core/box.h>
+#include <bond/ext/grpc/io_manager.h>
 #include <bond/ext/grpc/server.h>
 
 #include <boost/optional.hpp>
@@ -10,6 +12,11 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/test/debug.hpp>
 
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
 BOOST_AUTO_TEST_SUITE(ServerTests)
 
 class Service1 : public unit_test::Service1::Service
@@ -32,6 +39,27 @@ private:
     {}
 };
 
+class SimpleServiceImpl : public unit_test::SimpleService::Service
+{
+public:
+    using unit_test::SimpleService::Service::Service;
+
+private:
+    void IntToInt(bond::ext::grpc::unary_call<bond::Box<int32_t>, bond::Box<int32_t>> call) override
+    {
+        call.Finish(call.request());
+    }
+
+    void NothingToInt(bond::ext::grpc::unary_call<void, bond::Box<int32_t>>) override
+    {}
+
+    void IntToNothing(bond::ext::grpc::unary_call<bond::Box<int32_t>, bond::reflection::nothing>) override
+    {}
+
+    void NothingToNothing(bond::ext::grpc::unary_call<void, bond::reflection::nothing>) override
+    {}
+};
+
 auto scheduler = [](const std::function<void()>& f) { f(); };
 
 const std::string server_address = "127.0.0.1:50051";
@@ -136,6 +164,92 @@ BOOST_AUTO_TEST_CASE(AbstractNamedServiceStartTest)
     BOOST_CHECK_NO_THROW(bond::ext::grpc::server::Start(builder, std::move(services)));
 }
 
+BOOST_AUTO_TEST_CASE(MultipleCompletionQueuesTest)
+{
+    ::grpc::ServerBuilder builder;
+    builder.AddListeningPort(server_address, ::grpc::InsecureServerCredentials());
+
+    bond::ext::grpc::service_collection services;
+    services.Add(std::unique_ptr<SimpleServiceImpl>{ new SimpleServiceImpl{ scheduler } });
+    services.Add(std::unique_ptr<Service1>{ new Service1{ scheduler } });
+
+    bond::ext::grpc::server_options options;
+    options.completion_queues = 3;
+    options.threads_per_queue = 1;
+    options.pin_threads = true;
+
+    auto server = bond::ext::grpc::server::Start(builder, std::move(services), options);
+
+    unit_test::SimpleService::Client client(
+        ::grpc::CreateChannel(server_address, ::grpc::InsecureChannelCredentials()),
+        std::make_shared<bond::ext::grpc::io_manager>(),
+        scheduler);
+
+    std::vector<std::future<bond::ext::grpc::unary_call_result<bond::Box<int32_t>>>> results;
+
+    for (int32_t i = 0; i < 20; ++i)
+    {
+        results.push_back(client.AsyncIntToInt(bond::make_box(i)));
+    }
+
+    for (int32_t i = 0; i < 20; ++i)
+    {
+        BOOST_REQUIRE(results[i].wait_for(std::chrono::seconds(30)) == std::future_status::ready);
+        BOOST_CHECK_EQUAL(results[i].get().response().Deserialize().value, i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(MultipleReceivesPerMethodTest)
+{
+    ::grpc::ServerBuilder builder;
+    builder.AddListeningPort(server_address, ::grpc::InsecureServerCredentials());
+
+    // 8 receives for each method on each of the 2 completion queues
+    bond::ext::grpc::service_collection services;
+    services.Add(std::unique_ptr<SimpleServiceImpl>{ new SimpleServiceImpl{ scheduler, 8 } });
+
+    bond::ext::grpc::server_options options;
+    options.completion_queues = 2;
+
+    auto server = bond::ext::grpc::server::Start(builder, std::move(services), options);
+
+    unit_test::SimpleService::Client client(
+        ::grpc::CreateChannel(server_address, ::grpc::InsecureChannelCredentials()),
+        std::make_shared<bond::ext::grpc::io_manager>(),
+        scheduler);
+
+    std::vector<std::future<bond::ext::grpc::unary_call_result<bond::Box<int32_t>>>> results;
+
+    for (int32_t i = 0; i < 50; ++i)
+    {
+        results.push_back(client.AsyncIntToInt(bond::make_box(i)));
+    }
+
+    for (int32_t i = 0; i < 50; ++i)
+    {
+        BOOST_REQUIRE(results[i].wait_for(std::chrono::seconds(30)) == std::future_status::ready);
+        BOOST_CHECK_EQUAL(results[i].get().response().Deserialize().value, i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(QueuePerCoreStartTest)
+{
+    ::grpc::ServerBuilder builder;
+    builder.AddListeningPort(server_address, ::grpc::InsecureServerCredentials());
+
+    bond::ext::grpc::service_collection services;
+    services.Add(std::unique_ptr<Service1>{ new Service1{ scheduler } });
+
+    bond::ext::grpc::server_options options;
+    options.completion_queues = 0;
+
+    BOOST_CHECK_NO_THROW(
+        bond::ext::grpc::server::Start(
+            builder,
+            std::move(services),
+            options));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 bool init_unit_test()
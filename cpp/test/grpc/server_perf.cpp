@@ -0,0 +1,216 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "services_grpc.h"
+
+#include "../perf/benchmark.h"
+#include "event.h"
+
+#include <bond/core/box.h>
+#include <bond/ext/grpc/io_manager.h>
+#include <bond/ext/grpc/server.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace perf
+{
+
+namespace
+{
+
+using bond::ext::grpc::unary_call;
+using bond::ext::grpc::unary_call_result;
+
+auto inline_scheduler = [](const std::function<void()>& f) { f(); };
+
+
+class SimpleServiceImpl : public unit_test::SimpleService::Service
+{
+public:
+    using unit_test::SimpleService::Service::Service;
+
+private:
+    void IntToInt(unary_call<bond::Box<int32_t>, bond::Box<int32_t>> call) override
+    {
+        call.Finish(call.request());
+    }
+
+    void NothingToInt(unary_call<void, bond::Box<int32_t>> call) override
+    {
+        call.Finish(bond::Box<int32_t>{});
+    }
+
+    void IntToNothing(unary_call<bond::Box<int32_t>, bond::reflection::nothing>) override
+    {}
+
+    void NothingToNothing(unary_call<void, bond::reflection::nothing>) override
+    {}
+};
+
+
+// Server with the specified layout of completion queues and clients
+// keeping a fixed number of unary calls in flight against it. Callbacks run
+// inline on the polling threads, so that the throughput depends on the
+// completion queues rather than on a thread pool.
+class ServerFixture
+{
+public:
+    ServerFixture(
+        const std::string& address,
+        const bond::ext::grpc::server_options& options,
+        unsigned int receivesPerMethod)
+        : _server{ Start(address, options, receivesPerMethod) },
+          _ioManager{ std::make_shared<bond::ext::grpc::io_manager>() }
+    {
+        const unsigned int numClients = (std::max)(std::thread::hardware_concurrency() / 4, 1u);
+
+        for (unsigned int i = 0; i < numClients; ++i)
+        {
+            // Distinct arguments keep the channels from sharing a connection.
+            ::grpc::ChannelArguments args;
+            args.SetInt("bond.perf.channel", static_cast<int>(i));
+
+            _clients.emplace_back(new unit_test::SimpleService::Client{
+                ::grpc::CreateCustomChannel(address, ::grpc::InsecureChannelCredentials(), args),
+                _ioManager,
+                inline_scheduler });
+        }
+
+        _request.value = 42;
+    }
+
+    void Run(uint64_t iterations)
+    {
+        State state{ iterations };
+
+        for (uint64_t i = 0; i < callsInFlight; ++i)
+        {
+            Call(state);
+        }
+
+        state.done.wait();
+    }
+
+private:
+    static const uint64_t callsInFlight = 256;
+
+    struct State
+    {
+        explicit State(uint64_t iterations)
+            : iterations{ iterations },
+              issued{ 0 },
+              completed{ 0 }
+        {}
+
+        const uint64_t iterations;
+        std::atomic<uint64_t> issued;
+        std::atomic<uint64_t> completed;
+        unit_test::event done;
+    };
+
+    static bond::ext::grpc::server Start(
+        const std::string& address,
+        const bond::ext::grpc::server_options& options,
+        unsigned int receivesPerMethod)
+    {
+        ::grpc::ServerBuilder builder;
+        builder.AddListeningPort(address, ::grpc::InsecureServerCredentials());
+
+        bond::ext::grpc::service_collection services;
+        services.Add(std::unique_ptr<SimpleServiceImpl>{ new SimpleServiceImpl{ inline_scheduler, receivesPerMethod } });
+
+        return bond::ext::grpc::server::Start(builder, std::move(services), options);
+    }
+
+    void Call(State& state)
+    {
+        const uint64_t i = state.issued++;
+
+        if (i >= state.iterations)
+        {
+            return;
+        }
+
+        _clients[i % _clients.size()]->AsyncIntToInt(
+            _request,
+            [this, &state](const unary_call_result<bond::Box<int32_t>>&)
+            {
+                if (++state.completed == state.iterations)
+                {
+                    state.done.set();
+                }
+                else
+                {
+                    Call(state);
+                }
+            });
+    }
+
+    bond::ext::grpc::server _server;
+    std::shared_ptr<bond::ext::grpc::io_manager> _ioManager;
+    std::vector<std::unique_ptr<unit_test::SimpleService::Client>> _clients;
+    bond::Box<int32_t> _request;
+};
+
+
+void AddUnaryCalls(
+    BenchmarkSuite& suite,
+    const std::string& name,
+    const bond::ext::grpc::server_options& options,
+    int port,
+    unsigned int receivesPerMethod = 1)
+{
+    // The server is started the first time the benchmark runs and kept for
+    // the following runs.
+    auto fixture = std::make_shared<std::unique_ptr<ServerFixture>>();
+    const std::string address = "127.0.0.1:" + std::to_string(port);
+
+    suite.Add(name, 0, [fixture, address, options, receivesPerMethod](uint64_t iterations)
+    {
+        if (!*fixture)
+        {
+            fixture->reset(new ServerFixture{ address, options, receivesPerMethod });
+        }
+
+        (*fixture)->Run(iterations);
+    });
+}
+
+} // namespace
+
+
+void InitServerBenchmarks()
+{
+    BenchmarkSuite suite("Server");
+
+    // The default layout: one completion queue polled by one thread per core.
+    AddUnaryCalls(suite, "UnaryCalls/SingleQueue", bond::ext::grpc::server_options{}, 50071);
+
+    AddUnaryCalls(suite, "UnaryCalls/SingleQueue/16Receives", bond::ext::grpc::server_options{}, 50075, 16);
+
+    bond::ext::grpc::server_options perCore;
+    perCore.completion_queues = 0;
+    perCore.threads_per_queue = 1;
+
+    AddUnaryCalls(suite, "UnaryCalls/QueuePerCore", perCore, 50072);
+
+    perCore.pin_threads = true;
+
+    AddUnaryCalls(suite, "UnaryCalls/QueuePerCore/Pinned", perCore, 50073);
+
+    AddUnaryCalls(suite, "UnaryCalls/QueuePerCore/Pinned/4Receives", perCore, 50076, 4);
+
+    bond::ext::grpc::server_options fourQueues;
+    fourQueues.completion_queues = 4;
+    fourQueues.pin_threads = true;
+
+    AddUnaryCalls(suite, "UnaryCalls/FourQueues/Pinned", fourQueues, 50074);
+}
+
+} // namespace perf
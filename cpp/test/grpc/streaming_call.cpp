@@ -0,0 +1,275 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "event.h"
+#include "services_grpc.h"
+
+#include <bond/core/box.h>
+#include <bond/ext/grpc/io_manager.h>
+#include <bond/ext/grpc/server.h>
+#include <bond/ext/grpc/streaming_call.h>
+
+#include <boost/optional.hpp>
+#include <boost/test/unit_test.hpp>
+#include <boost/test/debug.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(StreamingCallTests)
+
+using Box = bond::Box<int32_t>;
+
+class StreamingServiceImpl : public unit_test::StreamingService::Service
+{
+public:
+    using unit_test::StreamingService::Service::Service;
+
+private:
+    void Range(bond::ext::grpc::server_streaming_call<Box, Box> call) override
+    {
+        const int32_t count = call.request().Deserialize().value;
+
+        if (count < 0)
+        {
+            // Dropped without being finished.
+            return;
+        }
+
+        for (int32_t i = 0; i < count; ++i)
+        {
+            call.Write(bond::make_box(i));
+        }
+
+        call.Finish();
+    }
+
+    void Sum(bond::ext::grpc::client_streaming_call<Box, Box> call) override
+    {
+        ReadSum(call, 0);
+    }
+
+    void Double(bond::ext::grpc::bidi_streaming_call<Box, Box> call) override
+    {
+        ReadDouble(call);
+    }
+
+    static void ReadSum(bond::ext::grpc::client_streaming_call<Box, Box> call, int32_t sum)
+    {
+        call.Read(
+            [call, sum](boost::optional<bond::bonded<Box>> msg) mutable
+            {
+                if (msg)
+                {
+                    ReadSum(call, sum + msg->Deserialize().value);
+                }
+                else
+                {
+                    call.Finish(bond::make_box(sum));
+                }
+            });
+    }
+
+    static void ReadDouble(bond::ext::grpc::bidi_streaming_call<Box, Box> call)
+    {
+        call.Read(
+            [call](boost::optional<bond::bonded<Box>> msg) mutable
+            {
+                if (msg)
+                {
+                    call.Write(bond::make_box(2 * msg->Deserialize().value));
+                    ReadDouble(call);
+                }
+                else
+                {
+                    call.Finish();
+                }
+            });
+    }
+};
+
+auto scheduler = [](const std::function<void()>& f) { f(); };
+
+const std::string server_address = "127.0.0.1:50052";
+
+struct StreamingFixture
+{
+    StreamingFixture()
+        : server{ Start() },
+          client{
+              ::grpc::CreateChannel(server_address, ::grpc::InsecureChannelCredentials()),
+              std::make_shared<bond::ext::grpc::io_manager>(),
+              scheduler }
+    {}
+
+    static bond::ext::grpc::server Start()
+    {
+        ::grpc::ServerBuilder builder;
+        builder.AddListeningPort(server_address, ::grpc::InsecureServerCredentials());
+
+        bond::ext::grpc::server_options options;
+        options.completion_queues = 2;
+
+        bond::ext::grpc::service_collection services;
+        services.Add(std::unique_ptr<StreamingServiceImpl>{ new StreamingServiceImpl{ scheduler } });
+
+        return bond::ext::grpc::server::Start(builder, std::move(services), options);
+    }
+
+    bond::ext::grpc::server server;
+    unit_test::StreamingService::Client client;
+};
+
+/// Collects the messages and the status of a call.
+struct Responses
+{
+    void Add(bond::bonded<Box> msg)
+    {
+        std::lock_guard<std::mutex> lock{ mutex };
+        values.push_back(msg.Deserialize().value);
+    }
+
+    void Finish(const ::grpc::Status& s)
+    {
+        status = s;
+        done.set();
+    }
+
+    std::mutex mutex;
+    std::vector<int32_t> values;
+    ::grpc::Status status;
+    unit_test::event done;
+};
+
+BOOST_FIXTURE_TEST_CASE(ServerStreamingTest, StreamingFixture)
+{
+    Responses responses;
+
+    client.AsyncRange(
+        bond::make_box(100),
+        [&responses](bond::bonded<Box> msg) { responses.Add(msg); },
+        [&responses](const ::grpc::Status& status) { responses.Finish(status); });
+
+    BOOST_REQUIRE(responses.done.wait_for(std::chrono::seconds(30)));
+    BOOST_CHECK(responses.status.ok());
+    BOOST_REQUIRE_EQUAL(responses.values.size(), 100u);
+
+    for (int32_t i = 0; i < 100; ++i)
+    {
+        BOOST_CHECK_EQUAL(responses.values[i], i);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(UnfinishedCallTest, StreamingFixture)
+{
+    Responses responses;
+
+    client.AsyncRange(
+        bond::make_box(-1),
+        [&responses](bond::bonded<Box> msg) { responses.Add(msg); },
+        [&responses](const ::grpc::Status& status) { responses.Finish(status); });
+
+    BOOST_REQUIRE(responses.done.wait_for(std::chrono::seconds(30)));
+    BOOST_CHECK_EQUAL(responses.status.error_code(), ::grpc::StatusCode::INTERNAL);
+    BOOST_CHECK(responses.values.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(ClientStreamingTest, StreamingFixture)
+{
+    unit_test::event done;
+    boost::optional<bond::ext::grpc::unary_call_result<Box>> result;
+
+    auto writer = client.AsyncSum(
+        [&](bond::ext::grpc::unary_call_result<Box> r)
+        {
+            result.emplace(std::move(r));
+            done.set();
+        });
+
+    unit_test::event written;
+    std::atomic<int32_t> writtenCount{ 0 };
+
+    for (int32_t i = 1; i <= 100; ++i)
+    {
+        writer.Write(
+            bond::make_box(i),
+            [&written, &writtenCount](bool ok)
+            {
+                if (ok && ++writtenCount == 100)
+                {
+                    written.set();
+                }
+            });
+    }
+
+    writer.WritesDone();
+
+    BOOST_REQUIRE(written.wait_for(std::chrono::seconds(30)));
+    BOOST_REQUIRE(done.wait_for(std::chrono::seconds(30)));
+    BOOST_REQUIRE(result);
+    BOOST_CHECK(result->status().ok());
+    BOOST_CHECK_EQUAL(result->response().Deserialize().value, 5050);
+    BOOST_CHECK_EQUAL(writer.pending_writes(), 0u);
+}
+
+BOOST_FIXTURE_TEST_CASE(ClientStreamingWritesDoneOnReleaseTest, StreamingFixture)
+{
+    unit_test::event done;
+    boost::optional<bond::ext::grpc::unary_call_result<Box>> result;
+
+    {
+        auto writer = client.AsyncSum(
+            [&](bond::ext::grpc::unary_call_result<Box> r)
+            {
+                result.emplace(std::move(r));
+                done.set();
+            });
+
+        writer.Write(bond::make_box(20));
+        writer.Write(bond::make_box(22));
+    }
+
+    BOOST_REQUIRE(done.wait_for(std::chrono::seconds(30)));
+    BOOST_REQUIRE(result);
+    BOOST_CHECK(result->status().ok());
+    BOOST_CHECK_EQUAL(result->response().Deserialize().value, 42);
+}
+
+BOOST_FIXTURE_TEST_CASE(BidiStreamingTest, StreamingFixture)
+{
+    Responses responses;
+
+    auto writer = client.AsyncDouble(
+        [&responses](bond::bonded<Box> msg) { responses.Add(msg); },
+        [&responses](const ::grpc::Status& status) { responses.Finish(status); });
+
+    for (int32_t i = 0; i < 50; ++i)
+    {
+        writer.Write(bond::make_box(i));
+    }
+
+    writer.WritesDone();
+
+    BOOST_REQUIRE(responses.done.wait_for(std::chrono::seconds(30)));
+    BOOST_CHECK(responses.status.ok());
+    BOOST_REQUIRE_EQUAL(responses.values.size(), 50u);
+
+    for (int32_t i = 0; i < 50; ++i)
+    {
+        BOOST_CHECK_EQUAL(responses.values[i], 2 * i);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+bool init_unit_test()
+{
+    // grpc allocates a bunch of stuff on-demand caused the leak tracker to
+    // report leaks. Disable it for this test.
+    boost::debug::detect_memory_leaks(false);
+
+    return true;
+}
@@ -5,15 +5,20 @@
     #pragma warning(disable : 4505) // disable "unreferenced local function has been removed" warning
 #endif
 
+#include <bond/ext/grpc/exception.h>
+#include <bond/ext/grpc/scheduler.h>
 #include <bond/ext/grpc/thread_pool.h>
+#include <bond/ext/grpc/work_stealing_thread_pool.h>
 
 // TODO: move unit_test_framework.h to cpp/test/inc
 #include "../core/unit_test_framework.h"
+#include "countdown_event.h"
 #include "event.h"
 
 #include <atomic>
 #include <chrono>
 #include <functional>
+#include <memory>
 #include <thread>
 
 #include <boost/optional.hpp>
@@ -95,8 +100,157 @@ public:
     }
 };
 
+class WorkStealingThreadPoolTests
+{
+    static void UseLambda()
+    {
+        bond::ext::grpc::work_stealing_thread_pool threads;
+        int sum = 0;
+        unit_test::event sum_event;
+
+        threads([&sum, &sum_event]
+        {
+            ++sum;
+            sum_event.set();
+        });
+
+        bool waitResult = sum_event.wait_for(std::chrono::seconds(30));
+
+        UT_AssertIsTrue(waitResult);
+        UT_AssertIsTrue(sum == 1);
+    }
+
+    static void UseMoveOnlyCallback()
+    {
+        bond::ext::grpc::work_stealing_thread_pool threads{ 2 };
+        int result = 0;
+        unit_test::event result_event;
+
+        std::unique_ptr<int> value{ new int{ 42 } };
+
+        bond::ext::grpc::Scheduler scheduler{ threads };
+        scheduler(std::bind(
+            [&result, &result_event](std::unique_ptr<int>& v)
+            {
+                result = *v;
+                result_event.set();
+            },
+            std::move(value)));
+
+        bool waitResult = result_event.wait_for(std::chrono::seconds(30));
+
+        UT_AssertIsTrue(waitResult);
+        UT_AssertIsTrue(result == 42);
+    }
+
+    static void RunNestedTasks()
+    {
+        const int count = 10000;
+
+        bond::ext::grpc::work_stealing_thread_pool threads{ 4 };
+        std::atomic<int> sum(0);
+        unit_test::countdown_event done(2 * count);
+
+        for (int i = 0; i < count; ++i)
+        {
+            threads([&threads, &sum, &done]
+            {
+                // Queued on the current thread, from which the other
+                // threads steal.
+                threads([&sum, &done]
+                {
+                    sum++;
+                    done.set();
+                });
+
+                sum++;
+                done.set();
+            });
+        }
+
+        bool waitResult = done.wait_for(std::chrono::seconds(30));
+
+        UT_AssertIsTrue(waitResult);
+        UT_AssertIsTrue(sum == 2 * count);
+    }
+
+    static void UsePinnedThreads()
+    {
+        bond::ext::grpc::work_stealing_thread_pool threads{ 2, { 0 } };
+        std::atomic<int> sum(0);
+        unit_test::countdown_event done(100);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            threads([&sum, &done]
+            {
+                sum++;
+                done.set();
+            });
+        }
+
+        bool waitResult = done.wait_for(std::chrono::seconds(30));
+
+        UT_AssertIsTrue(waitResult);
+        UT_AssertIsTrue(sum == 100);
+    }
+
+    static void FinishAllTasksAfterDelete()
+    {
+        boost::optional<bond::ext::grpc::work_stealing_thread_pool> threads;
+        threads.emplace(2);
+
+        std::atomic<int> sum(0);
+        auto increment = [&sum]
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            sum++;
+        };
+
+        (*threads)(increment);
+        (*threads)(increment);
+        (*threads)(increment);
+        (*threads)(increment);
+
+        // blocks until all schedule tasks are finished
+        threads.reset();
+
+        UT_AssertIsTrue(sum == 4);
+    }
+
+    static void ZeroThreadsThrows()
+    {
+        bool thrown = false;
+
+        try
+        {
+            bond::ext::grpc::work_stealing_thread_pool threads{ 0 };
+        }
+        catch (const bond::ext::grpc::InvalidThreadCount&)
+        {
+            thrown = true;
+        }
+
+        UT_AssertIsTrue(thrown);
+    }
+
+public:
+    static void Initialize()
+    {
+        UnitTestSuite suite("WorkStealingThreadPool");
+
+        suite.AddTestCase(UseLambda, "UseLambda");
+        suite.AddTestCase(UseMoveOnlyCallback, "UseMoveOnlyCallback");
+        suite.AddTestCase(RunNestedTasks, "RunNestedTasks");
+        suite.AddTestCase(UsePinnedThreads, "UsePinnedThreads");
+        suite.AddTestCase(FinishAllTasksAfterDelete, "FinishAllTasksAfterDelete");
+        suite.AddTestCase(ZeroThreadsThrows, "ZeroThreadsThrows");
+    }
+};
+
 bool init_unit_test()
 {
     BasicThreadPoolTests::Initialize();
+    WorkStealingThreadPoolTests::Initialize();
     return true;
 }
@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "../perf/benchmark.h"
+#include "countdown_event.h"
+
+#include <bond/ext/grpc/basic_thread_pool.h>
+#include <bond/ext/grpc/work_stealing_thread_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace perf
+{
+
+namespace
+{
+
+// The number of threads scheduling callbacks from outside of the pool, like
+// the threads polling the completion queues of a server.
+unsigned int ProducerCount()
+{
+    return (std::max)(std::thread::hardware_concurrency() / 2, 1u);
+}
+
+
+// Each callback is scheduled by one of several threads outside of the pool.
+template <typename ThreadPool>
+void ScheduleFromOutside(ThreadPool& threads, uint64_t iterations)
+{
+    const unsigned int producers = ProducerCount();
+    unit_test::countdown_event done(static_cast<size_t>(iterations));
+
+    std::vector<std::thread> threadsScheduling;
+    threadsScheduling.reserve(producers);
+
+    for (unsigned int p = 0; p < producers; ++p)
+    {
+        const uint64_t count = iterations / producers + (p < iterations % producers ? 1 : 0);
+
+        threadsScheduling.emplace_back([&threads, &done, count]
+        {
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                threads([&done] { done.set(); });
+            }
+        });
+    }
+
+    for (std::thread& t : threadsScheduling)
+    {
+        t.join();
+    }
+
+    done.wait();
+}
+
+
+// Chain of callbacks, each scheduling the next one from inside the pool
+// while there are callbacks left to schedule.
+template <typename ThreadPool>
+struct Chain
+{
+    void operator()() const
+    {
+        if (remaining->fetch_sub(1) > 0)
+        {
+            (*threads)(*this);
+        }
+
+        done->set();
+    }
+
+    ThreadPool* threads;
+    std::atomic<int64_t>* remaining;
+    unit_test::countdown_event* done;
+};
+
+
+// Callbacks are scheduled by other callbacks, as continuations of a call
+// are. A few chains per thread keep all the threads busy.
+template <typename ThreadPool>
+void ScheduleFromInside(ThreadPool& threads, uint64_t iterations)
+{
+    const uint64_t chains = (std::min)(uint64_t{ 4 } * std::thread::hardware_concurrency(), iterations);
+    std::atomic<int64_t> remaining(static_cast<int64_t>(iterations - chains));
+    unit_test::countdown_event done(static_cast<size_t>(iterations));
+
+    for (uint64_t i = 0; i < chains; ++i)
+    {
+        threads(Chain<ThreadPool>{ &threads, &remaining, &done });
+    }
+
+    done.wait();
+}
+
+
+template <typename ThreadPool>
+void AddThreadPool(BenchmarkSuite& suite, const std::string& name)
+{
+    // The pool is started the first time the benchmark runs and kept for
+    // the following runs.
+    auto threads = std::make_shared<std::unique_ptr<ThreadPool>>();
+
+    auto get = [threads]() -> ThreadPool&
+    {
+        if (!*threads)
+        {
+            threads->reset(new ThreadPool{});
+        }
+
+        return **threads;
+    };
+
+    suite.Add(name + "/FromOutside", 0, [get](uint64_t iterations)
+    {
+        ScheduleFromOutside(get(), iterations);
+    });
+
+    suite.Add(name + "/FromInside", 0, [get](uint64_t iterations)
+    {
+        ScheduleFromInside(get(), iterations);
+    });
+}
+
+} // namespace
+
+
+void InitThreadPoolBenchmarks()
+{
+    BenchmarkSuite suite("ThreadPool");
+
+    AddThreadPool<bond::ext::grpc::basic_thread_pool>(suite, "BasicThreadPool");
+
+    AddThreadPool<bond::ext::grpc::work_stealing_thread_pool>(suite, "WorkStealingThreadPool");
+}
+
+} // namespace perf
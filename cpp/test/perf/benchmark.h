@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <boost/core/noncopyable.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace perf
+{
+
+// Prevents the compiler from optimizing away computation of a value that
+// is otherwise unused by the benchmark.
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+
+// Benchmark function is called with the number of iterations to execute.
+typedef std::function<void (uint64_t iterations)> BenchmarkFunction;
+
+
+struct Benchmark
+{
+    std::string name;
+
+    // Number of payload bytes processed by a single iteration; 0 if the
+    // benchmark doesn't have a meaningful throughput.
+    uint64_t bytes;
+
+    BenchmarkFunction function;
+};
+
+
+struct BenchmarkResult
+{
+    uint64_t iterations;
+    double ns_per_op;
+    double bytes_per_second;
+};
+
+
+inline std::vector<Benchmark>& Benchmarks()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+
+// Groups related benchmarks under a common name prefix, similar to
+// UnitTestSuite in the unit tests.
+class BenchmarkSuite
+    : boost::noncopyable
+{
+public:
+    explicit BenchmarkSuite(const std::string& name)
+        : _name(name)
+    {}
+
+    void Add(const std::string& name, uint64_t bytes, BenchmarkFunction function)
+    {
+        Benchmark benchmark = { _name + "/" + name, bytes, std::move(function) };
+        Benchmarks().push_back(std::move(benchmark));
+    }
+
+private:
+    std::string _name;
+};
+
+
+// Runs the benchmark for at least minTime, doubling the number of iterations
+// until the elapsed time is long enough to be measured reliably.
+inline BenchmarkResult Run(const Benchmark& benchmark, std::chrono::duration<double> minTime)
+{
+    typedef std::chrono::steady_clock clock;
+
+    // Warm up caches and allocators.
+    benchmark.function(1);
+
+    for (uint64_t iterations = 1;; iterations *= 2)
+    {
+        const clock::time_point start = clock::now();
+        benchmark.function(iterations);
+        const std::chrono::duration<double> elapsed = clock::now() - start;
+
+        if (elapsed >= minTime || iterations >= (uint64_t(1) << 40))
+        {
+            BenchmarkResult result;
+
+            result.iterations = iterations;
+            result.ns_per_op = elapsed.count() * 1e9 / iterations;
+            result.bytes_per_second = benchmark.bytes * iterations / elapsed.count();
+
+            return result;
+        }
+
+        // Jump close to the target time once we have a usable measurement.
+        if (elapsed.count() > 0 && elapsed * 8 < minTime)
+        {
+            iterations = (std::max)(iterations,
+                static_cast<uint64_t>(iterations * (minTime.count() / elapsed.count()) / 4));
+        }
+    }
+}
+
+
+// Unit of the throughput column printed by Main.
+enum class Throughput
+{
+    Bytes,      // MB/s of Benchmark::bytes
+    Operations  // iterations per second
+};
+
+
+// Runs the benchmarks selected on the command line and prints their results,
+// one row per benchmark with the name padded to nameWidth characters.
+inline int Main(int argc, char* argv[], const char* program, double minTime, int nameWidth, Throughput throughput)
+{
+    std::string filter;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* arg = argv[i];
+
+        if (std::strncmp(arg, "--filter=", 9) == 0)
+        {
+            filter = arg + 9;
+        }
+        else if (std::strncmp(arg, "--min-time=", 11) == 0)
+        {
+            minTime = std::atof(arg + 11);
+        }
+        else if (std::strcmp(arg, "--list") == 0)
+        {
+            list = true;
+        }
+        else
+        {
+            std::cerr << "Usage: " << program << " [--filter=<substring>] [--min-time=<seconds>] [--list]" << std::endl;
+            return 1;
+        }
+    }
+
+    const int unitWidth = throughput == Throughput::Bytes ? 12 : 14;
+
+    if (!list)
+    {
+        std::cout << std::left << std::setw(nameWidth) << "Benchmark"
+                  << std::right << std::setw(14) << "Iterations"
+                  << std::setw(14) << "ns/op"
+                  << std::setw(unitWidth) << (throughput == Throughput::Bytes ? "MB/s" : "ops/s") << std::endl;
+    }
+
+    for (const Benchmark& benchmark : Benchmarks())
+    {
+        if (benchmark.name.find(filter) == std::string::npos)
+            continue;
+
+        if (list)
+        {
+            std::cout << benchmark.name << std::endl;
+            continue;
+        }
+
+        const BenchmarkResult result = Run(benchmark, std::chrono::duration<double>(minTime));
+
+        std::cout << std::left << std::setw(nameWidth) << benchmark.name
+                  << std::right << std::setw(14) << result.iterations
+                  << std::setw(14) << std::fixed << std::setprecision(1) << result.ns_per_op
+                  << std::setw(unitWidth);
+
+        if (throughput == Throughput::Bytes)
+        {
+            std::cout << std::setprecision(1) << result.bytes_per_second / (1024 * 1024);
+        }
+        else
+        {
+            std::cout << std::setprecision(0) << 1e9 / result.ns_per_op;
+        }
+
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
+
+} // namespace perf
@@ -0,0 +1,253 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include "perf_reflection.h"
+
+#include <bond/core/blob.h>
+
+#include <boost/make_shared.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+
+namespace perf
+{
+
+// Generates deterministic, representative instances of the benchmark
+// schemas. Values are spread over the whole range of each type so that
+// variable-length encodings are exercised with realistic lengths.
+class DataGenerator
+{
+public:
+    explicit DataGenerator(uint32_t seed = 42)
+        : _random(seed)
+    {}
+
+    template <typename T>
+    T Integer()
+    {
+        // Favor small values, as is typical for real-world payloads, while
+        // still producing occasional values that need the longest encoding.
+        const unsigned bits = std::uniform_int_distribution<unsigned>(1, sizeof(T) * 8)(_random);
+        const uint64_t mask = bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+        return static_cast<T>(std::uniform_int_distribution<uint64_t>()(_random) & mask);
+    }
+
+    double Real()
+    {
+        return std::uniform_real_distribution<double>(-1e6, 1e6)(_random);
+    }
+
+    std::string String(uint32_t maxLength = 32)
+    {
+        std::string s(std::uniform_int_distribution<uint32_t>(0, maxLength)(_random), ' ');
+
+        for (char& c : s)
+            c = static_cast<char>(std::uniform_int_distribution<int>('a', 'z')(_random));
+
+        return s;
+    }
+
+    std::wstring WString(uint32_t maxLength = 32)
+    {
+        const std::string s = String(maxLength);
+        return std::wstring(s.begin(), s.end());
+    }
+
+    bond::blob Blob(uint32_t length)
+    {
+        boost::shared_ptr<char[]> buffer = boost::make_shared_noinit<char[]>(length);
+
+        for (uint32_t i = 0; i < length; ++i)
+            buffer[i] = static_cast<char>(_random());
+
+        return bond::blob(buffer, length);
+    }
+
+    bond::perf::Primitives Primitives()
+    {
+        bond::perf::Primitives obj;
+
+        obj.b = (_random() & 1) != 0;
+        obj.u8 = Integer<uint8_t>();
+        obj.u16 = Integer<uint16_t>();
+        obj.u32 = Integer<uint32_t>();
+        obj.u64 = Integer<uint64_t>();
+        obj.i8 = Integer<int8_t>();
+        obj.i16 = Integer<int16_t>();
+        obj.i32 = Integer<int32_t>();
+        obj.i64 = Integer<int64_t>();
+        obj.f = static_cast<float>(Real());
+        obj.d = Real();
+        obj.str = String();
+        obj.wstr = WString();
+        obj.kind = bond::perf::Large;
+
+        return obj;
+    }
+
+    bond::perf::Deep Deep(uint32_t depth)
+    {
+        bond::perf::Deep obj;
+
+        obj.level = static_cast<int32_t>(depth);
+        obj.name = String(8);
+
+        if (depth > 0)
+            obj.child.set() = Deep(depth - 1);
+
+        return obj;
+    }
+
+    bond::perf::Wide Wide()
+    {
+        bond::perf::Wide obj;
+
+        obj.id = Integer<uint64_t>();
+        obj.tag = String();
+
+        // Fill every field through the compile-time schema.
+        bond::Apply(FillFields(*this), obj);
+
+        return obj;
+    }
+
+    bond::perf::Lists Lists(uint32_t count)
+    {
+        bond::perf::Lists obj;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            obj.int32s.push_back(Integer<int32_t>());
+            obj.int64s.push_back(Integer<int64_t>());
+            obj.uint32s.push_back(Integer<uint32_t>());
+            obj.uint64s.push_back(Integer<uint64_t>());
+            obj.uint16s.push_back(Integer<uint16_t>());
+            obj.floats.push_back(static_cast<float>(Real()));
+            obj.doubles.push_back(Real());
+            obj.uint8s.push_back(Integer<uint8_t>());
+            obj.int8s.push_back(Integer<int8_t>());
+            obj.bools.push_back((_random() & 1) != 0);
+        }
+
+        return obj;
+    }
+
+    bond::perf::Maps Maps(uint32_t count)
+    {
+        bond::perf::Maps obj;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            obj.strings[String(16)] = String(64);
+            obj.names[i] = String(16);
+            obj.values[String(16)] = Real();
+        }
+
+        return obj;
+    }
+
+    bond::perf::Blobs Blobs(uint32_t length, uint32_t chunks)
+    {
+        bond::perf::Blobs obj;
+
+        obj.data = Blob(length);
+
+        for (uint32_t i = 0; i < chunks; ++i)
+            obj.chunks.push_back(Blob(length / chunks));
+
+        return obj;
+    }
+
+    bond::perf::Records Records(uint32_t count)
+    {
+        bond::perf::Records obj;
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            obj.items.push_back(Primitives());
+
+            if (i % 16 == 0)
+                obj.trees.push_back(Deep(4));
+        }
+
+        return obj;
+    }
+
+    bond::perf::ExpandedEnvelope ExpandedEnvelope(uint32_t count)
+    {
+        bond::perf::ExpandedEnvelope obj;
+
+        obj.header = Primitives();
+        obj.payload = Lists(count);
+        obj.attributes = Maps(count / 16);
+
+        return obj;
+    }
+
+private:
+    class FillFields
+        : public bond::ModifyingTransform
+    {
+    public:
+        explicit FillFields(DataGenerator& generator)
+            : _generator(generator)
+        {}
+
+        void Begin(const bond::Metadata&) const
+        {}
+
+        void End() const
+        {}
+
+        void UnknownEnd() const
+        {}
+
+        template <typename T>
+        bool Base(T&) const
+        {
+            return false;
+        }
+
+        template <typename T>
+        bool Field(uint16_t, const bond::Metadata&, T& value) const
+        {
+            Fill(value);
+            return false;
+        }
+
+    private:
+        template <typename T>
+        typename boost::enable_if<std::is_integral<T> >::type
+        Fill(T& value) const
+        {
+            value = _generator.Integer<T>();
+        }
+
+        void Fill(bool& value) const
+        {
+            value = (_generator.Integer<uint8_t>() & 1) != 0;
+        }
+
+        void Fill(double& value) const
+        {
+            value = _generator.Real();
+        }
+
+        void Fill(std::string& value) const
+        {
+            value = _generator.String();
+        }
+
+        DataGenerator& _generator;
+    };
+
+    std::mt19937 _random;
+};
+
+} // namespace perf
@@ -0,0 +1,19 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "benchmark.h"
+
+namespace perf
+{
+    void InitProtocolBenchmarks();
+    void InitTransformBenchmarks();
+}
+
+
+int main(int argc, char* argv[])
+{
+    perf::InitProtocolBenchmarks();
+    perf::InitTransformBenchmarks();
+
+    return perf::Main(argc, argv, "bond_perf", 0.5, 72, perf::Throughput::Bytes);
+}
@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "benchmark.h"
+#include "data.h"
+#include "protocols.h"
+
+#include <boost/make_shared.hpp>
+
+namespace perf
+{
+
+template <typename Protocol, typename T>
+void AddSerialize(BenchmarkSuite& suite, const std::string& name, const T& value)
+{
+    typedef typename Protocol::Writer Writer;
+
+    // Share the object between copies of the benchmark function.
+    const boost::shared_ptr<const T> obj = boost::make_shared<T>(value);
+    const uint64_t bytes = Serialize<Protocol>(*obj).size();
+
+    suite.Add("Serialize/" + name, bytes, [obj](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            bond::OutputBuffer output;
+
+            Protocol::Write(output, [&obj](Writer& writer)
+            {
+                bond::Serialize(*obj, writer);
+            });
+
+            DoNotOptimize(output);
+        }
+    });
+}
+
+
+template <typename Protocol, typename T>
+void AddDeserialize(BenchmarkSuite& suite, const std::string& name, const T& value)
+{
+    const bond::blob data = Serialize<Protocol>(value);
+
+    suite.Add("Deserialize/" + name, data.size(), [data](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            T obj;
+
+            bond::Deserialize(CreateReader<Protocol>(data), obj);
+            DoNotOptimize(obj);
+        }
+    });
+}
+
+
+template <typename Protocol, typename T>
+void AddRoundtrip(BenchmarkSuite& suite, const std::string& name, const T& value)
+{
+    AddSerialize<Protocol>(suite, name, value);
+    AddDeserialize<Protocol>(suite, name, value);
+}
+
+
+template <typename Protocol>
+void AddProtocolBenchmarks()
+{
+    BenchmarkSuite suite(ProtocolName<Protocol>::Get());
+    DataGenerator generator;
+
+    AddRoundtrip<Protocol>(suite, "Primitives", generator.Primitives());
+    AddRoundtrip<Protocol>(suite, "Deep", generator.Deep(32));
+    AddRoundtrip<Protocol>(suite, "Wide", generator.Wide());
+    AddRoundtrip<Protocol>(suite, "Lists", generator.Lists(1024));
+    AddRoundtrip<Protocol>(suite, "Maps", generator.Maps(256));
+    AddRoundtrip<Protocol>(suite, "Blobs", generator.Blobs(64 * 1024, 16));
+    AddRoundtrip<Protocol>(suite, "Records", generator.Records(256));
+}
+
+
+void InitProtocolBenchmarks()
+{
+    AddProtocolBenchmarks<CompactBinaryV1>();
+    AddProtocolBenchmarks<CompactBinaryV2>();
+    AddProtocolBenchmarks<CompactBinaryV2SinglePass>();
+    AddProtocolBenchmarks<FastBinary>();
+    AddProtocolBenchmarks<SimpleBinaryV1>();
+    AddProtocolBenchmarks<SimpleBinaryV2>();
+
+#ifdef BOND_SIMPLE_JSON_PROTOCOL
+    AddProtocolBenchmarks<SimpleJson>();
+#endif
+}
+
+} // namespace perf
@@ -0,0 +1,159 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#include <bond/core/bond.h>
+#include <bond/stream/output_buffer.h>
+
+#ifdef BOND_SIMPLE_JSON_PROTOCOL
+#include <bond/protocol/simple_json_reader.h>
+#include <bond/protocol/simple_json_writer.h>
+#endif
+
+#include <string>
+
+namespace perf
+{
+
+// Constructs a writer/reader of the protocol, passing the version to the
+// protocols that support multiple versions.
+template <typename Writer>
+struct WriterFactory
+{
+    template <typename Buffer, typename Function>
+    static void Call(Buffer& output, uint16_t /*version*/, const Function& function)
+    {
+        Writer writer(output);
+        function(writer);
+    }
+};
+
+template <typename Buffer>
+struct WriterFactory<bond::CompactBinaryWriter<Buffer> >
+{
+    template <typename Function>
+    static void Call(Buffer& output, uint16_t version, const Function& function)
+    {
+        bond::CompactBinaryWriter<Buffer> writer(output, version);
+        function(writer);
+    }
+};
+
+template <typename Buffer>
+struct WriterFactory<bond::SimpleBinaryWriter<Buffer> >
+{
+    template <typename Function>
+    static void Call(Buffer& output, uint16_t version, const Function& function)
+    {
+        bond::SimpleBinaryWriter<Buffer> writer(output, version);
+        function(writer);
+    }
+};
+
+
+template <typename Reader>
+struct ReaderFactory
+{
+    static Reader Create(const bond::blob& data, uint16_t /*version*/)
+    {
+        return Reader(bond::InputBuffer(data));
+    }
+};
+
+template <typename Buffer>
+struct ReaderFactory<bond::CompactBinaryReader<Buffer> >
+{
+    static bond::CompactBinaryReader<Buffer> Create(const bond::blob& data, uint16_t version)
+    {
+        return bond::CompactBinaryReader<Buffer>(Buffer(data), version);
+    }
+};
+
+template <typename Buffer>
+struct ReaderFactory<bond::SimpleBinaryReader<Buffer> >
+{
+    static bond::SimpleBinaryReader<Buffer> Create(const bond::blob& data, uint16_t version)
+    {
+        return bond::SimpleBinaryReader<Buffer>(Buffer(data), version);
+    }
+};
+
+
+// Describes a protocol under test: reader type and protocol version.
+template <typename ReaderT, uint16_t Version = bond::default_version<ReaderT>::value>
+struct Protocol
+{
+    typedef ReaderT Reader;
+    typedef typename bond::get_protocol_writer<Reader, bond::OutputBuffer>::type Writer;
+
+    static const uint16_t version = Version;
+
+    template <typename Function>
+    static void Write(bond::OutputBuffer& output, const Function& function)
+    {
+        WriterFactory<Writer>::Call(output, version, function);
+    }
+};
+
+
+typedef Protocol<bond::CompactBinaryReader<bond::InputBuffer>, bond::v1> CompactBinaryV1;
+typedef Protocol<bond::CompactBinaryReader<bond::InputBuffer>, bond::v2> CompactBinaryV2;
+
+// Compact Binary v2 with struct lengths back-patched in a single pass.
+struct CompactBinaryV2SinglePass
+    : CompactBinaryV2
+{
+    template <typename Function>
+    static void Write(bond::OutputBuffer& output, const Function& function)
+    {
+        Writer writer(output, version, true);
+        function(writer);
+    }
+};
+
+typedef Protocol<bond::FastBinaryReader<bond::InputBuffer> > FastBinary;
+typedef Protocol<bond::SimpleBinaryReader<bond::InputBuffer>, bond::v1> SimpleBinaryV1;
+typedef Protocol<bond::SimpleBinaryReader<bond::InputBuffer>, bond::v2> SimpleBinaryV2;
+
+#ifdef BOND_SIMPLE_JSON_PROTOCOL
+typedef Protocol<bond::SimpleJsonReader<bond::InputBuffer> > SimpleJson;
+#endif
+
+
+template <typename Protocol>
+struct ProtocolName;
+
+template <> struct ProtocolName<CompactBinaryV1> { static const char* Get() { return "CompactBinaryV1"; } };
+template <> struct ProtocolName<CompactBinaryV2> { static const char* Get() { return "CompactBinaryV2"; } };
+template <> struct ProtocolName<CompactBinaryV2SinglePass> { static const char* Get() { return "CompactBinaryV2SinglePass"; } };
+template <> struct ProtocolName<FastBinary> { static const char* Get() { return "FastBinary"; } };
+template <> struct ProtocolName<SimpleBinaryV1> { static const char* Get() { return "SimpleBinaryV1"; } };
+template <> struct ProtocolName<SimpleBinaryV2> { static const char* Get() { return "SimpleBinaryV2"; } };
+
+#ifdef BOND_SIMPLE_JSON_PROTOCOL
+template <> struct ProtocolName<SimpleJson> { static const char* Get() { return "SimpleJson"; } };
+#endif
+
+
+template <typename Protocol>
+typename Protocol::Reader CreateReader(const bond::blob& data)
+{
+    return ReaderFactory<typename Protocol::Reader>::Create(data, Protocol::version);
+}
+
+
+template <typename Protocol, typename T>
+bond::blob Serialize(const T& obj)
+{
+    bond::OutputBuffer output;
+
+    Protocol::Write(output, [&obj](typename Protocol::Writer& writer)
+    {
+        bond::Serialize(obj, writer);
+    });
+
+    return output.GetBuffer();
+}
+
+} // namespace perf
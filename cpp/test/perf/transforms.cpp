@@ -0,0 +1,287 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include "benchmark.h"
+#include "data.h"
+#include "protocols.h"
+
+#include <bond/core/compiled_schema.h>
+
+namespace perf
+{
+
+// Transcoding between protocols using the compile-time schema.
+template <typename From, typename To, typename T>
+void AddTranscode(BenchmarkSuite& suite, const std::string& name, const T& value)
+{
+    typedef typename To::Writer Writer;
+
+    const bond::blob data = Serialize<From>(value);
+    const std::string protocols = std::string(ProtocolName<From>::Get()) + "-" + ProtocolName<To>::Get();
+
+    suite.Add("Transcode/" + protocols + "/" + name, data.size(), [data](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            bond::OutputBuffer output;
+
+            To::Write(output, [&data](Writer& writer)
+            {
+                bond::bonded<T>(CreateReader<From>(data)).Serialize(writer);
+            });
+
+            DoNotOptimize(output);
+        }
+    });
+
+    // Same transcoding, driven by the runtime schema.
+    suite.Add("TranscodeRuntimeSchema/" + protocols + "/" + name, data.size(), [data](uint64_t iterations)
+    {
+        const bond::RuntimeSchema schema(bond::GetRuntimeSchema<T>());
+
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            bond::OutputBuffer output;
+
+            To::Write(output, [&data, &schema](Writer& writer)
+            {
+                bond::bonded<void>(CreateReader<From>(data), schema).Serialize(writer);
+            });
+
+            DoNotOptimize(output);
+        }
+    });
+
+    // Same transcoding, with the concrete reader instead of ProtocolReader.
+    suite.Add("TranscodeDirect/" + protocols + "/" + name, data.size(), [data](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            bond::OutputBuffer output;
+
+            To::Write(output, [&data](Writer& writer)
+            {
+                bond::Transcode<T>(CreateReader<From>(data), writer);
+            });
+
+            DoNotOptimize(output);
+        }
+    });
+}
+
+
+// Transcoding driven by the runtime schema compiled once, which is only
+// supported from tagged protocols.
+template <typename From, typename To, typename T>
+void AddTranscodeCompiledSchema(BenchmarkSuite& suite, const std::string& name, const T& value)
+{
+    typedef typename To::Writer Writer;
+
+    const bond::blob data = Serialize<From>(value);
+    const std::string protocols = std::string(ProtocolName<From>::Get()) + "-" + ProtocolName<To>::Get();
+
+    suite.Add("TranscodeCompiledSchema/" + protocols + "/" + name, data.size(), [data](uint64_t iterations)
+    {
+        const bond::CompiledSchema schema(bond::GetRuntimeSchema<T>());
+
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            bond::OutputBuffer output;
+
+            To::Write(output, [&data, &schema](Writer& writer)
+            {
+                auto reader = CreateReader<From>(data);
+                bond::Transcode(schema, reader, writer);
+            });
+
+            DoNotOptimize(output);
+        }
+    });
+}
+
+
+template <typename Protocol, typename T>
+void AddDeserializeRuntimeSchema(BenchmarkSuite& suite, const std::string& name, const T& value)
+{
+    const bond::blob data = Serialize<Protocol>(value);
+
+    suite.Add("DeserializeRuntimeSchema/" + std::string(ProtocolName<Protocol>::Get()) + "/" + name, data.size(),
+        [data](uint64_t iterations)
+    {
+        const bond::RuntimeSchema schema(bond::GetRuntimeSchema<T>());
+
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            T obj;
+
+            bond::Deserialize(CreateReader<Protocol>(data), obj, schema);
+            DoNotOptimize(obj);
+        }
+    });
+}
+
+
+template <typename Protocol, typename T>
+void AddMarshal(BenchmarkSuite& suite, const std::string& name, const T& value)
+{
+    typedef typename Protocol::Writer Writer;
+
+    const boost::shared_ptr<const T> obj = boost::make_shared<T>(value);
+    bond::OutputBuffer marshaled;
+
+    Protocol::Write(marshaled, [&obj](Writer& writer)
+    {
+        bond::Marshal<bond::BuiltInProtocols>(*obj, writer);
+    });
+
+    const bond::blob data = marshaled.GetBuffer();
+    const std::string suffix = std::string(ProtocolName<Protocol>::Get()) + "/" + name;
+
+    suite.Add("Marshal/" + suffix, data.size(), [obj](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            bond::OutputBuffer output;
+
+            Protocol::Write(output, [&obj](Writer& writer)
+            {
+                bond::Marshal<bond::BuiltInProtocols>(*obj, writer);
+            });
+
+            DoNotOptimize(output);
+        }
+    });
+
+    suite.Add("Unmarshal/" + suffix, data.size(), [data](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            T obj;
+
+            bond::Unmarshal(bond::InputBuffer(data), obj);
+            DoNotOptimize(obj);
+        }
+    });
+}
+
+
+// Merges the view object into a payload serialized with the full schema.
+template <typename Protocol, typename View, typename T>
+void AddMerge(BenchmarkSuite& suite, const std::string& name, const View& view, const T& value)
+{
+    typedef typename Protocol::Writer Writer;
+
+    const boost::shared_ptr<const View> obj = boost::make_shared<View>(view);
+    const bond::blob data = Serialize<Protocol>(value);
+
+    suite.Add("Merge/" + std::string(ProtocolName<Protocol>::Get()) + "/" + name, data.size(),
+        [obj, data](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            bond::OutputBuffer output;
+
+            Protocol::Write(output, [&obj, &data](Writer& writer)
+            {
+                bond::Merge(*obj, CreateReader<Protocol>(data), writer);
+            });
+
+            DoNotOptimize(output);
+        }
+    });
+}
+
+
+// Compares deserialization of a struct with bonded<T> fields, which are
+// kept in their serialized form, to the equivalent fully typed struct, and
+// measures re-serialization of the bonded payload.
+template <typename Protocol, typename To>
+void AddPassThrough(BenchmarkSuite& suite, const bond::perf::ExpandedEnvelope& value)
+{
+    typedef typename To::Writer Writer;
+
+    const bond::blob data = Serialize<Protocol>(value);
+    const std::string protocols = std::string(ProtocolName<Protocol>::Get()) + "-" + ProtocolName<To>::Get();
+
+    suite.Add("PassThrough/" + protocols + "/Envelope", data.size(), [data](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            bond::perf::Envelope obj;
+            bond::OutputBuffer output;
+
+            bond::Deserialize(CreateReader<Protocol>(data), obj);
+
+            To::Write(output, [&obj](Writer& writer)
+            {
+                bond::Serialize(obj, writer);
+            });
+
+            DoNotOptimize(output);
+        }
+    });
+
+    suite.Add("PassThrough/" + protocols + "/ExpandedEnvelope", data.size(), [data](uint64_t iterations)
+    {
+        for (uint64_t i = 0; i < iterations; ++i)
+        {
+            bond::perf::ExpandedEnvelope obj;
+            bond::OutputBuffer output;
+
+            bond::Deserialize(CreateReader<Protocol>(data), obj);
+
+            To::Write(output, [&obj](Writer& writer)
+            {
+                bond::Serialize(obj, writer);
+            });
+
+            DoNotOptimize(output);
+        }
+    });
+}
+
+
+void InitTransformBenchmarks()
+{
+    BenchmarkSuite suite("Transforms");
+    DataGenerator generator;
+
+    const bond::perf::Records records = generator.Records(256);
+    const bond::perf::Wide wide = generator.Wide();
+    const bond::perf::ExpandedEnvelope envelope = generator.ExpandedEnvelope(1024);
+
+    AddTranscode<CompactBinaryV2, FastBinary>(suite, "Records", records);
+    AddTranscode<FastBinary, CompactBinaryV2>(suite, "Records", records);
+    AddTranscode<FastBinary, CompactBinaryV2SinglePass>(suite, "Records", records);
+    AddTranscodeCompiledSchema<CompactBinaryV2, FastBinary>(suite, "Records", records);
+    AddTranscodeCompiledSchema<FastBinary, CompactBinaryV2>(suite, "Records", records);
+    AddTranscode<CompactBinaryV2, SimpleBinaryV2>(suite, "Wide", wide);
+
+#ifdef BOND_SIMPLE_JSON_PROTOCOL
+    AddTranscode<CompactBinaryV2, SimpleJson>(suite, "Records", records);
+    AddTranscode<SimpleJson, CompactBinaryV2>(suite, "Wide", wide);
+#endif
+
+    AddDeserializeRuntimeSchema<CompactBinaryV2>(suite, "Records", records);
+    AddDeserializeRuntimeSchema<CompactBinaryV2>(suite, "Wide", wide);
+
+#ifdef BOND_SIMPLE_JSON_PROTOCOL
+    AddDeserializeRuntimeSchema<SimpleJson>(suite, "Wide", wide);
+#endif
+
+    AddMarshal<CompactBinaryV2>(suite, "Records", records);
+    AddMarshal<FastBinary>(suite, "Records", records);
+
+    bond::perf::PrimitivesView view;
+    view.u32 = 42;
+    view.i64 = -42;
+    view.str = "merged";
+
+    AddMerge<CompactBinaryV2>(suite, "Primitives", view, generator.Primitives());
+    AddMerge<CompactBinaryV2>(suite, "Wide", wide, wide);
+
+    AddPassThrough<CompactBinaryV2, CompactBinaryV2>(suite, envelope);
+    AddPassThrough<CompactBinaryV2, FastBinary>(suite, envelope);
+}
+
+} // namespace perf
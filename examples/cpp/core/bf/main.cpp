@@ -3,7 +3,7 @@
 #include "input_file.h"
 #include <bond/core/cmdargs.h>
 #include <bond/protocol/simple_json_writer.h>
-#include <bond/stream/stdio_output_stream.h>
+#include <bond/stream/file_output_stream.h>
 #include <errno.h>
 #include <iostream>
 #include <stdio.h>
@@ -197,44 +197,50 @@ bool TranscodeFrom(Reader reader, const Options& options)
         file = OpenFile(options.output.c_str(), "wb");
     }
 
-    bond::StdioOutputStream out(file);
+    bond::FileOutputStream out(file);
 
     switch (options.to)
     {
         case compact:
         {
-            bond::CompactBinaryWriter<bond::StdioOutputStream> writer(out);
+            bond::CompactBinaryWriter<bond::FileOutputStream> writer(out);
             TranscodeFromTo(reader, writer, options);
+            out.Flush();
             return true;
         }
         case compact2:
         {
-            bond::CompactBinaryWriter<bond::StdioOutputStream> writer(out, bond::v2);
+            bond::CompactBinaryWriter<bond::FileOutputStream> writer(out, bond::v2);
             TranscodeFromTo(reader, writer, options);
+            out.Flush();
             return true;
         }
         case fast:
         {
-            bond::FastBinaryWriter<bond::StdioOutputStream> writer(out);
+            bond::FastBinaryWriter<bond::FileOutputStream> writer(out);
             TranscodeFromTo(reader, writer, options);
+            out.Flush();
             return true;
         }
         case simple:
         {
-            bond::SimpleBinaryWriter<bond::StdioOutputStream> writer(out);
+            bond::SimpleBinaryWriter<bond::FileOutputStream> writer(out);
             TranscodeFromTo(reader, writer, options);
+            out.Flush();
             return true;
         }
         case simple2:
         {
-            bond::SimpleBinaryWriter<bond::StdioOutputStream> writer(out, bond::v2);
+            bond::SimpleBinaryWriter<bond::FileOutputStream> writer(out, bond::v2);
             TranscodeFromTo(reader, writer, options);
+            out.Flush();
             return true;
         }
         case json:
         {
-            bond::SimpleJsonWriter<bond::StdioOutputStream> writer(out, true, 4, options.all_fields);
+            bond::SimpleJsonWriter<bond::FileOutputStream> writer(out, true, 4, options.all_fields);
             TranscodeFromTo(reader, writer, options);
+            out.Flush();
             return true;
         }
         default: